@@ -2,14 +2,19 @@
 
 #include <memory>
 #include <thread>
+#include <atomic>
 #include <mutex>
 #include <optional>
 #include <condition_variable>
 #include <chrono>
 #include <deque>
+#include <list>
 #include <queue>
 #include <optional>
 #include <vector>
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
 #include <iostream>
 #include <string>
 #include <algorithm>
@@ -22,4 +27,5 @@
 
 #include <boost/asio.hpp>
 
-const int HEADER_SIZE = 4;
\ No newline at end of file
+const int HEADER_SIZE = 4;
+const size_t MAX_BODY_SIZE = 64 * 1024;
\ No newline at end of file
@@ -6,10 +6,102 @@
 #include <string>
 #include <stdexcept>
 #include "User/include/UserEntity.hpp"
+#include "DB/include/RowBinder.hpp"
+
+template<>
+struct RowMapping<UserEntity>
+{
+    static constexpr const char* COLUMNS = "id, user_id, username, email, is_alive";
+    static constexpr auto Fields = std::make_tuple(&UserEntity::m_Id, &UserEntity::m_UserId, &UserEntity::m_Username, &UserEntity::m_Email, &UserEntity::m_IsAlive);
+};
+
+struct FriendRequestRow
+{
+    uint32_t senderId = 0;
+    uint32_t receiverId = 0;
+};
+
+template<>
+struct RowMapping<FriendRequestRow>
+{
+    static constexpr const char* COLUMNS = "sender_id, receiver_id";
+    static constexpr auto Fields = std::make_tuple(&FriendRequestRow::senderId, &FriendRequestRow::receiverId);
+};
+
+struct FriendshipRow
+{
+    uint32_t userId1 = 0;
+    uint32_t userId2 = 0;
+};
+
+template<>
+struct RowMapping<FriendshipRow>
+{
+    static constexpr const char* COLUMNS = "user_id1, user_id2";
+    static constexpr auto Fields = std::make_tuple(&FriendshipRow::userId1, &FriendshipRow::userId2);
+};
 
 class MySQLManager {
 private:
-    std::unique_ptr<MYSQL, decltype(&mysql_close)> m_Connection;
+    using StatementPtr = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>;
+
+    struct PooledConnection
+    {
+        std::unique_ptr<MYSQL, decltype(&mysql_close)> handle{ nullptr, mysql_close };
+        std::unordered_map<std::string, StatementPtr> statements;
+        std::chrono::steady_clock::time_point lastUsedTime;
+        bool needsCheck = false;
+    };
+
+    class ConnectionGuard
+    {
+    public:
+        ConnectionGuard(MySQLManager& manager, PooledConnection* connection, bool pinned);
+        ~ConnectionGuard();
+
+        ConnectionGuard(const ConnectionGuard&) = delete;
+        ConnectionGuard& operator=(const ConnectionGuard&) = delete;
+
+        MYSQL* get() const { return m_Connection->handle.get(); }
+        MYSQL_STMT* Prepare(const std::string& query);
+
+    private:
+        MySQLManager& m_Manager;
+        PooledConnection* m_Connection;
+        bool m_Pinned;
+        int m_UncaughtExceptions;
+        MYSQL_STMT* m_Statement = nullptr;
+        StatementPtr m_UncachedStatement{ nullptr, mysql_stmt_close };
+    };
+
+    struct MySQLThreadGuard
+    {
+        MySQLThreadGuard();
+        ~MySQLThreadGuard();
+    };
+
+    struct PinnedConnection
+    {
+        const MySQLManager* owner = nullptr;
+        PooledConnection* connection = nullptr;
+    };
+
+    static constexpr std::chrono::seconds HEALTH_CHECK_INTERVAL{ 30 };
+    static constexpr size_t MAX_CACHED_STATEMENTS = 64;
+
+    std::string m_Host;
+    std::string m_User;
+    std::string m_Password;
+    std::string m_Database;
+    unsigned int m_Port;
+    std::chrono::milliseconds m_MaxWait;
+
+    std::vector<std::unique_ptr<PooledConnection>> m_Connections;
+    std::vector<PooledConnection*> m_IdleConnections;
+    std::mutex m_PoolMutex;
+    std::condition_variable m_PoolCV;
+
+    static thread_local PinnedConnection t_PinnedConnection;
 
 public:
     struct Condition 
@@ -18,17 +110,22 @@ public:
         std::string value;
     };
 
-    MySQLManager(const std::string& host, const std::string& user, const std::string& password, const std::string& db, unsigned int port = 3306);
-    
+    MySQLManager(const std::string& host, const std::string& user, const std::string& password, const std::string& db, unsigned int port = 3306,
+        size_t poolSize = 1, std::chrono::milliseconds maxWait = std::chrono::milliseconds(3000));
+
+    size_t GetPoolSize() const { return m_Connections.size(); }
+
     void BeginTransaction();
     void CommitTransaction();
     void RollbackTransaction();
 
     bool AddFriendRequest(const std::string& sender_id, const std::string& receiver_id);
     bool AddFriendship(const std::string& sender_id, const std::string& receiver_id);
-    bool HasFriendRequest(const std::string& sender_id, const std::string& receiver_id);
+    std::vector<FriendRequestRow> GetFriendRequests(const std::string& user_id);
+    std::vector<FriendshipRow> GetFriendships(const std::string& user_id);
 
     std::shared_ptr<UserEntity> GetUserById(const std::string& user_id);
+    std::vector<std::shared_ptr<UserEntity>> GetUsersByIds(const std::vector<std::string>& user_ids);
     std::shared_ptr<UserEntity> GetUserByConditions(const std::vector<Condition>& conditions);
 
     void UpdateFriend(const std::string& senderId, const std::string& receiverId, const std::string& status);
@@ -37,5 +134,12 @@ public:
 
 
 private:
+    ConnectionGuard AcquireConnection();
+    PooledConnection* CheckoutConnection();
+    void ReleaseConnection(PooledConnection* connection, bool failed);
+    void Connect(PooledConnection& connection);
+    void CheckConnection(PooledConnection& connection);
+
     void executePreparedStatement(const std::string& query, std::vector<std::string>& params);
+    void bindAndExecute(MYSQL_STMT* stmt, const std::vector<std::string>& params);
 };
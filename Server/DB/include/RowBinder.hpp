@@ -0,0 +1,197 @@
+#pragma once
+#include "Common.h"
+#include <mysql.h>
+#include <tuple>
+
+// 결과 행을 받을 구조체별로 특수화
+// COLUMNS: SELECT 할 컬럼 목록, Fields: 같은 순서의 멤버 포인터
+template<typename T>
+struct RowMapping;
+
+// 필드 타입별로 MYSQL_BIND 를 필드에 연결하고, fetch 후 길이를 맞추는 방법
+template<typename Field>
+struct ColumnBinder;
+
+template<>
+struct ColumnBinder<uint32_t>
+{
+    static void Bind(MYSQL_BIND& bind, uint32_t& field)
+    {
+        bind.buffer_type = MYSQL_TYPE_LONG;
+        bind.buffer = &field;
+        bind.is_unsigned = 1;
+    }
+
+    static void Complete(MYSQL_STMT*, MYSQL_BIND&, unsigned int, uint32_t&, unsigned long) {}
+};
+
+template<>
+struct ColumnBinder<uint64_t>
+{
+    static void Bind(MYSQL_BIND& bind, uint64_t& field)
+    {
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        bind.buffer = &field;
+        bind.is_unsigned = 1;
+    }
+
+    static void Complete(MYSQL_STMT*, MYSQL_BIND&, unsigned int, uint64_t&, unsigned long) {}
+};
+
+// 한 글자 컬럼 (더 긴 값은 첫 글자만 사용)
+template<>
+struct ColumnBinder<char>
+{
+    static void Bind(MYSQL_BIND& bind, char& field)
+    {
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = &field;
+        bind.buffer_length = sizeof(field);
+    }
+
+    static void Complete(MYSQL_STMT*, MYSQL_BIND&, unsigned int, char&, unsigned long) {}
+};
+
+// 문자열은 중간 버퍼 없이 std::string 의 버퍼에 바로 받음
+template<>
+struct ColumnBinder<std::string>
+{
+    static void Bind(MYSQL_BIND& bind, std::string& field)
+    {
+        // 이미 확보된 용량만큼 받고, 넘치는 값은 Complete 에서 다시 읽음
+        field.resize(field.capacity());
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = field.data();
+        bind.buffer_length = field.size();
+    }
+
+    static void Complete(MYSQL_STMT* stmt, MYSQL_BIND& bind, unsigned int column, std::string& field, unsigned long length)
+    {
+        if (length > field.size())
+        {
+            // 잘린 컬럼은 실제 길이만큼 늘린 뒤 그 컬럼만 다시 읽음
+            field.resize(length);
+            bind.buffer = field.data();
+            bind.buffer_length = length;
+            if (mysql_stmt_fetch_column(stmt, &bind, column, 0) != 0)
+            {
+                throw std::runtime_error(mysql_stmt_error(stmt));
+            }
+        }
+        field.resize(length);
+    }
+};
+
+// 실행된 statement 의 결과 행을 RowMapping<T> 에 따라 T 의 필드로 바로 읽어오는 클래스
+template<typename T>
+class RowBinder
+{
+private:
+    using Mapping = RowMapping<T>;
+    using NullFlag = std::remove_pointer_t<decltype(MYSQL_BIND::is_null)>;
+
+    static constexpr size_t COLUMN_COUNT = std::tuple_size_v<std::decay_t<decltype(Mapping::Fields)>>;
+
+    MYSQL_STMT* m_Stmt;
+    std::array<MYSQL_BIND, COLUMN_COUNT> m_Binds;
+    std::array<unsigned long, COLUMN_COUNT> m_Lengths;
+    std::array<NullFlag, COLUMN_COUNT> m_IsNull;
+
+public:
+    explicit RowBinder(MYSQL_STMT* stmt)
+        : m_Stmt(stmt)
+    {
+    }
+
+    // 다음 행을 row 에 읽어옵니다. (남은 행이 없으면 false)
+    bool Fetch(T& row)
+    {
+        // 행마다 받을 객체가 달라지므로 결과 버퍼를 다시 연결 (서버 통신 없음)
+        BindColumns(row, std::make_index_sequence<COLUMN_COUNT>());
+        if (mysql_stmt_bind_result(m_Stmt, m_Binds.data()) != 0)
+        {
+            throw std::runtime_error(mysql_stmt_error(m_Stmt));
+        }
+
+        int status = mysql_stmt_fetch(m_Stmt);
+        if (status == MYSQL_NO_DATA)
+        {
+            return false;
+        }
+        if (status != 0 && status != MYSQL_DATA_TRUNCATED)
+        {
+            throw std::runtime_error(mysql_stmt_error(m_Stmt));
+        }
+
+        CompleteColumns(row, std::make_index_sequence<COLUMN_COUNT>());
+        return true;
+    }
+
+    // 남은 행을 모두 값으로 읽어 반환합니다. (작은 행 구조체용)
+    std::vector<T> FetchAllValues(size_t expectedCount = 0)
+    {
+        std::vector<T> rows;
+        rows.reserve(expectedCount);
+        T row;
+        while (Fetch(row))
+        {
+            rows.push_back(std::move(row));
+            row = T();
+        }
+        return rows;
+    }
+
+    // 남은 행을 모두 읽어 반환합니다.
+    std::vector<std::shared_ptr<T>> FetchAll(size_t expectedCount = 0)
+    {
+        std::vector<std::shared_ptr<T>> rows;
+        rows.reserve(expectedCount);
+        while (true)
+        {
+            auto row = std::make_shared<T>();
+            if (!Fetch(*row))
+            {
+                break;
+            }
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+private:
+    template<size_t Index>
+    static auto& FieldOf(T& row)
+    {
+        return row.*std::get<Index>(Mapping::Fields);
+    }
+
+    template<size_t... Index>
+    void BindColumns(T& row, std::index_sequence<Index...>)
+    {
+        memset(m_Binds.data(), 0, sizeof(MYSQL_BIND) * COLUMN_COUNT);
+        (BindColumn<Index>(row), ...);
+    }
+
+    template<size_t Index>
+    void BindColumn(T& row)
+    {
+        auto& field = FieldOf<Index>(row);
+        ColumnBinder<std::decay_t<decltype(field)>>::Bind(m_Binds[Index], field);
+        m_Binds[Index].length = &m_Lengths[Index];
+        m_Binds[Index].is_null = &m_IsNull[Index];
+    }
+
+    template<size_t... Index>
+    void CompleteColumns(T& row, std::index_sequence<Index...>)
+    {
+        (CompleteColumn<Index>(row), ...);
+    }
+
+    template<size_t Index>
+    void CompleteColumn(T& row)
+    {
+        auto& field = FieldOf<Index>(row);
+        unsigned long length = m_IsNull[Index] ? 0 : m_Lengths[Index];
+        ColumnBinder<std::decay_t<decltype(field)>>::Complete(m_Stmt, m_Binds[Index], static_cast<unsigned int>(Index), field, length);
+    }
+};
@@ -1,39 +1,92 @@
 #include "DB/include/MySQLManager.h"
 
-MySQLManager::MySQLManager(const std::string& host, const std::string& user, const std::string& password, const std::string& db, unsigned int port)
-    : m_Connection(mysql_init(nullptr), mysql_close)
+thread_local MySQLManager::PinnedConnection MySQLManager::t_PinnedConnection;
+
+MySQLManager::MySQLThreadGuard::MySQLThreadGuard()
 {
+    mysql_thread_init();
+}
 
-    if (!m_Connection) 
+MySQLManager::MySQLThreadGuard::~MySQLThreadGuard()
+{
+    mysql_thread_end();
+}
+
+MySQLManager::MySQLManager(const std::string& host, const std::string& user, const std::string& password, const std::string& db, unsigned int port,
+    size_t poolSize, std::chrono::milliseconds maxWait)
+    : m_Host(host)
+    , m_User(user)
+    , m_Password(password)
+    , m_Database(db)
+    , m_Port(port)
+    , m_MaxWait(maxWait)
+{
+    if (mysql_library_init(0, nullptr, nullptr) != 0)
     {
         throw std::runtime_error("MySQL initialization failed");
     }
 
-    if (!mysql_real_connect(m_Connection.get(), host.c_str(), user.c_str(), password.c_str(), db.c_str(), port, nullptr, 0)) 
+    poolSize = std::max<size_t>(1, poolSize);
+    m_Connections.reserve(poolSize);
+    m_IdleConnections.reserve(poolSize);
+    for (size_t i = 0; i < poolSize; ++i)
     {
-        throw std::runtime_error(mysql_error(m_Connection.get()));
+        auto connection = std::make_unique<PooledConnection>();
+        Connect(*connection);
+        m_IdleConnections.push_back(connection.get());
+        m_Connections.push_back(std::move(connection));
     }
 }
 
-bool MySQLManager::AddFriendRequest(const std::string& senderId, const std::string& receiverId)
+MySQLManager::ConnectionGuard::ConnectionGuard(MySQLManager& manager, PooledConnection* connection, bool pinned)
+    : m_Manager(manager)
+    , m_Connection(connection)
+    , m_Pinned(pinned)
+    , m_UncaughtExceptions(std::uncaught_exceptions())
 {
-    std::string query = "INSERT INTO friend_requests (sender_id, receiver_id, status) VALUES (?, ?, 'P')";
-    std::vector<std::string> params = { senderId, receiverId };
+}
 
-    try 
+MySQLManager::ConnectionGuard::~ConnectionGuard()
+{
+    bool failed = std::uncaught_exceptions() > m_UncaughtExceptions;
+    if (m_Statement)
     {
-        executePreparedStatement(query, params);
+        mysql_stmt_free_result(m_Statement);
+        if (failed && !m_UncachedStatement)
+        {
+            auto& statements = m_Connection->statements;
+            auto it = std::find_if(statements.begin(), statements.end(), [this](const auto& entry) { return entry.second.get() == m_Statement; });
+            if (it != statements.end())
+            {
+                statements.erase(it);
+            }
+        }
     }
-    catch (const std::exception& e) 
+    m_UncachedStatement.reset();
+
+    if (m_Pinned)
     {
-        throw std::runtime_error("Failed to add user: " + std::string(e.what()));
+        if (failed)
+        {
+            m_Connection->needsCheck = true;
+        }
+        return;
     }
+
+    m_Manager.ReleaseConnection(m_Connection, failed);
 }
 
-void MySQLManager::executePreparedStatement(const std::string& query, std::vector<std::string>& params)
+MYSQL_STMT* MySQLManager::ConnectionGuard::Prepare(const std::string& query)
 {
-    std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)> stmt(mysql_stmt_init(m_Connection.get()), mysql_stmt_close);
+    auto& statements = m_Connection->statements;
+    auto it = statements.find(query);
+    if (it != statements.end())
+    {
+        m_Statement = it->second.get();
+        return m_Statement;
+    }
 
+    StatementPtr stmt(mysql_stmt_init(get()), mysql_stmt_close);
     if (!stmt)
     {
         throw std::runtime_error("Failed to initialize statement");
@@ -44,352 +97,324 @@ void MySQLManager::executePreparedStatement(const std::string& query, std::vecto
         throw std::runtime_error(mysql_stmt_error(stmt.get()));
     }
 
-    std::vector<MYSQL_BIND> bindParams(params.size());
-    std::vector<std::string> paramValues(params.size());
-    for (size_t i = 0; i < params.size(); ++i)
+    m_Statement = stmt.get();
+    if (statements.size() < MAX_CACHED_STATEMENTS)
     {
-        paramValues[i] = params[i];
-        bindParams[i].buffer_type = MYSQL_TYPE_STRING;
-        bindParams[i].buffer = (char*)paramValues[i].c_str();
-        bindParams[i].buffer_length = paramValues[i].size();
-        bindParams[i].is_null = 0;
+        statements.emplace(query, std::move(stmt));
     }
-
-    if (mysql_stmt_bind_param(stmt.get(), bindParams.data()) != 0)
+    else
     {
-        throw std::runtime_error(mysql_stmt_error(stmt.get()));
+        m_UncachedStatement = std::move(stmt);
     }
+    return m_Statement;
+}
 
-    if (mysql_stmt_execute(stmt.get()) != 0)
+void MySQLManager::Connect(PooledConnection& connection)
+{
+    connection.statements.clear();
+    connection.handle.reset(mysql_init(nullptr));
+    if (!connection.handle)
     {
-        throw std::runtime_error(mysql_stmt_error(stmt.get()));
+        throw std::runtime_error("MySQL initialization failed");
     }
 
-    if (mysql_stmt_store_result(stmt.get()) != 0)
+    if (!mysql_real_connect(connection.handle.get(), m_Host.c_str(), m_User.c_str(), m_Password.c_str(), m_Database.c_str(), m_Port, nullptr, 0))
     {
-        throw std::runtime_error(mysql_stmt_error(stmt.get()));
+        std::string error = mysql_error(connection.handle.get());
+        connection.handle.reset();
+        throw std::runtime_error(error);
     }
 
-    int numRowsAffected = mysql_stmt_affected_rows(stmt.get());
+    connection.lastUsedTime = std::chrono::steady_clock::now();
+    connection.needsCheck = false;
+}
 
-    if (numRowsAffected < 1)
+void MySQLManager::CheckConnection(PooledConnection& connection)
+{
+    if (connection.handle && !connection.needsCheck && std::chrono::steady_clock::now() - connection.lastUsedTime < HEALTH_CHECK_INTERVAL)
     {
-        throw std::runtime_error("Failed to get number of rows affected");
+        return;
     }
 
-    std::cout << "Number of rows affected: " << numRowsAffected << std::endl;
+    if (!connection.handle || mysql_ping(connection.handle.get()) != 0)
+    {
+        Connect(connection);
+    }
+    connection.needsCheck = false;
 }
 
-void MySQLManager::UpdateFriend(const std::string& senderId, const std::string& receiverId, const std::string& status)
+MySQLManager::PooledConnection* MySQLManager::CheckoutConnection()
 {
-    std::string query = "UPDATE friend_requests SET status = ? WHERE sender_id = ? AND receiver_id = ?";
-    std::vector<std::string> params = { status, senderId, receiverId };
+    static thread_local MySQLThreadGuard threadGuard;
 
-    try 
+    PooledConnection* connection = nullptr;
     {
-        executePreparedStatement(query, params);
+        std::unique_lock<std::mutex> lock(m_PoolMutex);
+        if (!m_PoolCV.wait_for(lock, m_MaxWait, [this]() { return !m_IdleConnections.empty(); }))
+        {
+            throw std::runtime_error("Timed out waiting for a MySQL connection");
+        }
+        connection = m_IdleConnections.back();
+        m_IdleConnections.pop_back();
     }
-    catch (const std::exception& e) 
+
+    try
     {
-        throw std::runtime_error("Failed to update user: " + std::string(e.what()));
+        CheckConnection(*connection);
     }
+    catch (const std::exception&)
+    {
+        ReleaseConnection(connection, true);
+        throw;
+    }
+
+    return connection;
 }
 
-void MySQLManager::DeleteFriendRequest(const std::string& senderId, const std::string& receiverId)
+MySQLManager::ConnectionGuard MySQLManager::AcquireConnection()
 {
-    std::string query = "DELETE FROM friend_requests WHERE sender_id = ? AND receiver_id = ?";
-    std::vector<std::string> params = { senderId, receiverId };
+    if (t_PinnedConnection.owner == this)
+    {
+        return ConnectionGuard(*this, t_PinnedConnection.connection, true);
+    }
 
-    try
+    return ConnectionGuard(*this, CheckoutConnection(), false);
+}
+
+void MySQLManager::ReleaseConnection(PooledConnection* connection, bool failed)
+{
+    connection->lastUsedTime = std::chrono::steady_clock::now();
+    if (failed)
     {
-        executePreparedStatement(query, params);
+        connection->needsCheck = true;
     }
-    catch (const std::exception& e)
+
     {
-        throw std::runtime_error("Failed to update user: " + std::string(e.what()));
+        std::scoped_lock lock(m_PoolMutex);
+        m_IdleConnections.push_back(connection);
     }
+    m_PoolCV.notify_one();
 }
 
-
-bool MySQLManager::AddFriendship(const std::string& userId1, const std::string& userId2)
+bool MySQLManager::AddFriendRequest(const std::string& senderId, const std::string& receiverId)
 {
-    std::string query = "INSERT INTO friendships (user_id1, user_id2) VALUES (?, ?)";
-    std::vector<std::string> params = { userId1, userId2 };
+    std::string query = "INSERT INTO friend_requests (sender_id, receiver_id, status) SELECT ?, ?, 'P' FROM DUAL WHERE NOT EXISTS "
+        "(SELECT 1 FROM friend_requests WHERE ((sender_id = ? AND receiver_id = ?) OR (sender_id = ? AND receiver_id = ?)) AND (status = 'P' OR status = 'A'))";
+    std::vector<std::string> params = { senderId, receiverId, senderId, receiverId, receiverId, senderId };
 
-    try
+    try 
     {
         executePreparedStatement(query, params);
     }
-    catch (const std::exception& e)
+    catch (const std::exception& e) 
     {
         throw std::runtime_error("Failed to add user: " + std::string(e.what()));
     }
+
+    return true;
 }
 
-bool MySQLManager::HasFriendRequest(const std::string& senderId, const std::string& receiverId)
+void MySQLManager::executePreparedStatement(const std::string& query, std::vector<std::string>& params)
 {
-    try
+    int numRowsAffected = 0;
     {
-        std::string query = "SELECT COUNT(*) AS count FROM friend_requests WHERE sender_id = ? AND receiver_id = ? AND (status = 'P' OR status = 'A')";
-        std::vector<std::string> params = { senderId, receiverId };
-        int count = 0;
-
-        auto stmt = mysql_stmt_init(m_Connection.get());
-        if (!stmt)
-        {
-            throw std::runtime_error("Failed to initialize statement");
-        }
+        auto connection = AcquireConnection();
+        MYSQL_STMT* stmt = connection.Prepare(query);
+        bindAndExecute(stmt, params);
 
-        if (mysql_stmt_prepare(stmt, query.c_str(), query.size()) != 0)
+        if (mysql_stmt_store_result(stmt) != 0)
         {
             throw std::runtime_error(mysql_stmt_error(stmt));
         }
 
-        std::vector<MYSQL_BIND> bindParams(params.size());
-        std::vector<std::string> paramValues(params.size());
-        for (size_t i = 0; i < params.size(); ++i)
-        {
-            paramValues[i] = params[i];
-            bindParams[i].buffer_type = MYSQL_TYPE_STRING;
-            bindParams[i].buffer = (char*)paramValues[i].c_str();
-            bindParams[i].buffer_length = paramValues[i].size();
-            bindParams[i].is_null = 0;
-        }
-
-        if (mysql_stmt_bind_param(stmt, bindParams.data()) != 0)
-        {
-            throw std::runtime_error(mysql_stmt_error(stmt));
-        }
+        numRowsAffected = mysql_stmt_affected_rows(stmt);
+    }
 
-        if (mysql_stmt_execute(stmt) != 0)
-        {
-            throw std::runtime_error(mysql_stmt_error(stmt));
-        }
+    if (numRowsAffected < 1)
+    {
+        throw std::runtime_error("Failed to get number of rows affected");
+    }
 
-        MYSQL_BIND result;
-        memset(&result, 0, sizeof(result));
-        result.buffer_type = MYSQL_TYPE_LONG;
-        result.buffer = &count;
+    std::cout << "Number of rows affected: " << numRowsAffected << std::endl;
+}
 
-        if (mysql_stmt_bind_result(stmt, &result) != 0)
-        {
-            throw std::runtime_error(mysql_stmt_error(stmt));
-        }
+void MySQLManager::UpdateFriend(const std::string& senderId, const std::string& receiverId, const std::string& status)
+{
+    std::string query = "UPDATE friend_requests SET status = ? WHERE sender_id = ? AND receiver_id = ? AND status = 'P'";
+    std::vector<std::string> params = { status, senderId, receiverId };
 
-        if (mysql_stmt_fetch(stmt) != 0)
-        {
-            throw std::runtime_error(mysql_stmt_error(stmt));
-        }
+    try 
+    {
+        executePreparedStatement(query, params);
+    }
+    catch (const std::exception& e) 
+    {
+        throw std::runtime_error("Failed to update user: " + std::string(e.what()));
+    }
+}
 
-        mysql_stmt_free_result(stmt);
-        mysql_stmt_close(stmt);
+void MySQLManager::DeleteFriendRequest(const std::string& senderId, const std::string& receiverId)
+{
+    std::string query = "DELETE FROM friend_requests WHERE sender_id = ? AND receiver_id = ? AND status = 'P'";
+    std::vector<std::string> params = { senderId, receiverId };
 
-        return count > 0;
+    try
+    {
+        executePreparedStatement(query, params);
     }
     catch (const std::exception& e)
     {
-        std::cerr << "Error in HasPendingFriendRequest: " << e.what() << std::endl;
-        return false;
+        throw std::runtime_error("Failed to update user: " + std::string(e.what()));
     }
 }
 
-std::shared_ptr<UserEntity> MySQLManager::GetUserById(const std::string& requestId) 
+
+bool MySQLManager::AddFriendship(const std::string& userId1, const std::string& userId2)
 {
-    std::string query = "SELECT id, user_id, password, username, email, is_alive FROM user WHERE id = ?";
-    std::vector<std::string> params = { requestId };
+    std::string query = "INSERT INTO friendships (user_id1, user_id2) VALUES (?, ?)";
+    std::vector<std::string> params = { userId1, userId2 };
 
-    MYSQL_STMT* stmt = mysql_stmt_init(m_Connection.get());
-    if (!stmt) 
+    try
     {
-        throw std::runtime_error("Failed to initialize statement");
+        executePreparedStatement(query, params);
     }
-
-    if (mysql_stmt_prepare(stmt, query.c_str(), query.size()) != 0) 
+    catch (const std::exception& e)
     {
-        throw std::runtime_error(mysql_stmt_error(stmt));
+        throw std::runtime_error("Failed to add user: " + std::string(e.what()));
     }
 
+    return true;
+}
+
+void MySQLManager::bindAndExecute(MYSQL_STMT* stmt, const std::vector<std::string>& params)
+{
     std::vector<MYSQL_BIND> bindParams(params.size());
-    std::vector<std::string> paramValues(params.size());
-    for (size_t i = 0; i < params.size(); ++i) 
+    memset(bindParams.data(), 0, sizeof(MYSQL_BIND) * bindParams.size());
+    for (size_t i = 0; i < params.size(); ++i)
     {
-        paramValues[i] = params[i];
         bindParams[i].buffer_type = MYSQL_TYPE_STRING;
-        bindParams[i].buffer = (char*)paramValues[i].c_str();
-        bindParams[i].buffer_length = paramValues[i].size();
-        bindParams[i].is_null = 0;
+        bindParams[i].buffer = (char*)params[i].c_str();
+        bindParams[i].buffer_length = params[i].size();
     }
 
-    if (mysql_stmt_bind_param(stmt, bindParams.data()) != 0) 
+    if (mysql_stmt_bind_param(stmt, bindParams.data()) != 0)
     {
         throw std::runtime_error(mysql_stmt_error(stmt));
     }
 
-    if (mysql_stmt_execute(stmt) != 0) 
+    if (mysql_stmt_execute(stmt) != 0)
     {
         throw std::runtime_error(mysql_stmt_error(stmt));
     }
+}
 
-    std::shared_ptr<UserEntity> user = std::make_shared<UserEntity>();
-
-    MYSQL_BIND result[6];
-    memset(result, 0, sizeof(result));
-
-    uint64_t id;
-    char userId[100];
-    char password[255];
-    char username[100];
-    char email[255];
-    char isAlive;
+std::vector<FriendRequestRow> MySQLManager::GetFriendRequests(const std::string& userId)
+{
+    std::string query = std::string("SELECT ") + RowMapping<FriendRequestRow>::COLUMNS + " FROM friend_requests WHERE (sender_id = ? OR receiver_id = ?) AND (status = 'P' OR status = 'A')";
+    std::vector<std::string> params = { userId, userId };
 
-    result[0].buffer_type = MYSQL_TYPE_LONGLONG;
-    result[0].buffer = &id;
+    auto connection = AcquireConnection();
+    MYSQL_STMT* stmt = connection.Prepare(query);
+    bindAndExecute(stmt, params);
 
-    result[1].buffer_type = MYSQL_TYPE_STRING;
-    result[1].buffer = userId;
-    result[1].buffer_length = sizeof(userId);
+    RowBinder<FriendRequestRow> binder(stmt);
+    return binder.FetchAllValues();
+}
 
-    result[2].buffer_type = MYSQL_TYPE_STRING;
-    result[2].buffer = password;
-    result[2].buffer_length = sizeof(password);
+std::vector<FriendshipRow> MySQLManager::GetFriendships(const std::string& userId)
+{
+    std::string query = std::string("SELECT ") + RowMapping<FriendshipRow>::COLUMNS + " FROM friendships WHERE user_id1 = ? OR user_id2 = ?";
+    std::vector<std::string> params = { userId, userId };
 
-    result[3].buffer_type = MYSQL_TYPE_STRING;
-    result[3].buffer = username;
-    result[3].buffer_length = sizeof(username);
+    auto connection = AcquireConnection();
+    MYSQL_STMT* stmt = connection.Prepare(query);
+    bindAndExecute(stmt, params);
 
-    result[4].buffer_type = MYSQL_TYPE_STRING;
-    result[4].buffer = email;
-    result[4].buffer_length = sizeof(email);
+    RowBinder<FriendshipRow> binder(stmt);
+    return binder.FetchAllValues();
+}
 
-    result[5].buffer_type = MYSQL_TYPE_STRING;
-    result[5].buffer = &isAlive;
-    result[5].buffer_length = sizeof(isAlive);
+std::shared_ptr<UserEntity> MySQLManager::GetUserById(const std::string& requestId) 
+{
+    std::string query = std::string("SELECT ") + RowMapping<UserEntity>::COLUMNS + " FROM user WHERE id = ?";
+    std::vector<std::string> params = { requestId };
 
-    if (mysql_stmt_bind_result(stmt, result) != 0) 
-    {
-        throw std::runtime_error(mysql_stmt_error(stmt));
-    }
+    auto connection = AcquireConnection();
+    MYSQL_STMT* stmt = connection.Prepare(query);
+    bindAndExecute(stmt, params);
 
-    if (mysql_stmt_fetch(stmt) == 0) 
-    {
-        user->SetId(id);
-        user->SetUserId(userId);
-        //user->SetPassword(password);
-        user->SetUsername(username);
-        user->SetEmail(email);
-        user->SetIsAlive(isAlive);
-    }
-    else 
+    std::shared_ptr<UserEntity> user = std::make_shared<UserEntity>();
+    RowBinder<UserEntity> binder(stmt);
+    if (!binder.Fetch(*user))
     {
-        throw std::runtime_error("User with id " + requestId + " not found");
+        return nullptr;
     }
 
     mysql_stmt_free_result(stmt);
-    mysql_stmt_close(stmt);
 
     return user;
 }
 
-std::shared_ptr<UserEntity> MySQLManager::GetUserByConditions(const std::vector<Condition>& conditions)
+std::vector<std::shared_ptr<UserEntity>> MySQLManager::GetUsersByIds(const std::vector<std::string>& requestIds)
 {
-    std::string query = "SELECT id, user_id, password, username, email, is_alive FROM user WHERE ";
-    std::vector<std::string> params;
-
-    for (size_t i = 0; i < conditions.size(); ++i)
+    std::vector<std::shared_ptr<UserEntity>> users;
+    if (requestIds.empty())
     {
-        if (i > 0) query += " AND ";
-        query += conditions[i].column + " = ?";
-        params.push_back(conditions[i].value);
+        return users;
     }
 
-    MYSQL_STMT* stmt = mysql_stmt_init(m_Connection.get());
-    if (!stmt)
+    size_t placeholderCount = 1;
+    while (placeholderCount < requestIds.size())
     {
-        throw std::runtime_error("Failed to initialize statement");
+        placeholderCount <<= 1;
     }
 
-    if (mysql_stmt_prepare(stmt, query.c_str(), query.size()) != 0)
+    std::string query = std::string("SELECT ") + RowMapping<UserEntity>::COLUMNS + " FROM user WHERE id IN (";
+    for (size_t i = 0; i < placeholderCount; ++i)
     {
-        throw std::runtime_error(mysql_stmt_error(stmt));
+        query += (i > 0) ? ", ?" : "?";
     }
+    query += ")";
 
-    std::vector<MYSQL_BIND> bindParams(params.size());
-    std::vector<std::string> paramValues(params.size());
-    for (size_t i = 0; i < params.size(); ++i)
-    {
-        paramValues[i] = params[i];
-        bindParams[i].buffer_type = MYSQL_TYPE_STRING;
-        bindParams[i].buffer = (char*)paramValues[i].c_str();
-        bindParams[i].buffer_length = paramValues[i].size();
-        bindParams[i].is_null = 0;
-    }
+    auto connection = AcquireConnection();
+    MYSQL_STMT* stmt = connection.Prepare(query);
 
-    if (mysql_stmt_bind_param(stmt, bindParams.data()) != 0)
-    {
-        throw std::runtime_error(mysql_stmt_error(stmt));
-    }
+    std::vector<std::string> params(requestIds);
+    params.resize(placeholderCount, requestIds.back());
+    bindAndExecute(stmt, params);
 
-    if (mysql_stmt_execute(stmt) != 0)
-    {
-        throw std::runtime_error(mysql_stmt_error(stmt));
-    }
-
-    std::shared_ptr<UserEntity> user = std::make_shared<UserEntity>();
+    RowBinder<UserEntity> binder(stmt);
+    users = binder.FetchAll(requestIds.size());
 
-    MYSQL_BIND result[6];
-    memset(result, 0, sizeof(result));
-
-    uint64_t id;
-    char userId[100];
-    char password[255];
-    char username[100];
-    char email[255];
-    char isAlive;
-
-    result[0].buffer_type = MYSQL_TYPE_LONGLONG;
-    result[0].buffer = &id;
-
-    result[1].buffer_type = MYSQL_TYPE_STRING;
-    result[1].buffer = userId;
-    result[1].buffer_length = sizeof(userId);
-
-    result[2].buffer_type = MYSQL_TYPE_STRING;
-    result[2].buffer = password;
-    result[2].buffer_length = sizeof(password);
-
-    result[3].buffer_type = MYSQL_TYPE_STRING;
-    result[3].buffer = username;
-    result[3].buffer_length = sizeof(username);
+    mysql_stmt_free_result(stmt);
 
-    result[4].buffer_type = MYSQL_TYPE_STRING;
-    result[4].buffer = email;
-    result[4].buffer_length = sizeof(email);
+    return users;
+}
 
-    result[5].buffer_type = MYSQL_TYPE_STRING;
-    result[5].buffer = &isAlive;
-    result[5].buffer_length = sizeof(isAlive);
+std::shared_ptr<UserEntity> MySQLManager::GetUserByConditions(const std::vector<Condition>& conditions)
+{
+    std::string query = std::string("SELECT ") + RowMapping<UserEntity>::COLUMNS + " FROM user WHERE ";
+    std::vector<std::string> params;
 
-    if (mysql_stmt_bind_result(stmt, result) != 0)
+    for (size_t i = 0; i < conditions.size(); ++i)
     {
-        throw std::runtime_error(mysql_stmt_error(stmt));
+        if (i > 0) query += " AND ";
+        query += conditions[i].column + " = ?";
+        params.push_back(conditions[i].value);
     }
 
-    if (mysql_stmt_fetch(stmt) == 0)
-    {
-        user->SetId(id);
-        user->SetUserId(userId);
-        //user->SetPassword(password);
-        user->SetUsername(username);
-        user->SetEmail(email);
-        user->SetIsAlive(isAlive);
-    }
-    else
+    auto connection = AcquireConnection();
+    MYSQL_STMT* stmt = connection.Prepare(query);
+    bindAndExecute(stmt, params);
+
+    std::shared_ptr<UserEntity> user = std::make_shared<UserEntity>();
+    RowBinder<UserEntity> binder(stmt);
+    if (!binder.Fetch(*user))
     {
-        throw std::runtime_error("User not found with given conditions");
+        return nullptr;
     }
 
     mysql_stmt_free_result(stmt);
-    mysql_stmt_close(stmt);
 
     return user;
 }
@@ -397,26 +422,57 @@ std::shared_ptr<UserEntity> MySQLManager::GetUserByConditions(const std::vector<
 
 void MySQLManager::BeginTransaction()
 {
-    if (mysql_autocommit(m_Connection.get(), false) != 0)
+    if (t_PinnedConnection.owner == this)
     {
-        throw std::runtime_error("Failed to start transaction: " + std::string(mysql_error(m_Connection.get())));
+        throw std::runtime_error("Failed to start transaction: transaction already in progress");
     }
+
+    PooledConnection* connection = CheckoutConnection();
+    if (mysql_autocommit(connection->handle.get(), false) != 0)
+    {
+        std::string error = mysql_error(connection->handle.get());
+        ReleaseConnection(connection, true);
+        throw std::runtime_error("Failed to start transaction: " + error);
+    }
+
+    t_PinnedConnection = { this, connection };
 }
 
 void MySQLManager::CommitTransaction()
 {
-    if (mysql_commit(m_Connection.get()) != 0)
+    if (t_PinnedConnection.owner != this)
+    {
+        throw std::runtime_error("Failed to commit transaction: no transaction in progress");
+    }
+
+    PooledConnection* connection = t_PinnedConnection.connection;
+    if (mysql_commit(connection->handle.get()) != 0)
     {
-        throw std::runtime_error("Failed to commit transaction: " + std::string(mysql_error(m_Connection.get())));
+        throw std::runtime_error("Failed to commit transaction: " + std::string(mysql_error(connection->handle.get())));
     }
-    mysql_autocommit(m_Connection.get(), true); // Restore autocommit mode
+    mysql_autocommit(connection->handle.get(), true); // Restore autocommit mode
+
+    t_PinnedConnection = {};
+    ReleaseConnection(connection, false);
 }
 
 void MySQLManager::RollbackTransaction()
 {
-    if (mysql_rollback(m_Connection.get()) != 0)
+    if (t_PinnedConnection.owner != this)
+    {
+        return;
+    }
+
+    PooledConnection* connection = t_PinnedConnection.connection;
+    t_PinnedConnection = {};
+
+    bool failed = mysql_rollback(connection->handle.get()) != 0;
+    std::string error = failed ? mysql_error(connection->handle.get()) : "";
+    mysql_autocommit(connection->handle.get(), true); // Restore autocommit mode
+    ReleaseConnection(connection, failed);
+
+    if (failed)
     {
-        throw std::runtime_error("Failed to rollback transaction: " + std::string(mysql_error(m_Connection.get())));
+        throw std::runtime_error("Failed to rollback transaction: " + error);
     }
-    mysql_autocommit(m_Connection.get(), true); // Restore autocommit mode
 }
\ No newline at end of file
@@ -1,27 +1,48 @@
 #pragma once
 #include "Common.h"
 
+class UserSession;
+
+struct PartyMember
+{
+    uint32_t                    id;
+    std::weak_ptr<UserSession>  session;
+};
+
 class Party : public std::enable_shared_from_this<Party>
 {
 private:
     uint32_t                m_PartyId;
     std::string             m_PartyName;
-    uint32_t                m_PartyCreator;
-    std::vector<uint32_t>   m_Members;
+    std::atomic<uint32_t>   m_PartyCreator;
+    std::vector<PartyMember> m_Members;
+    mutable std::mutex      m_MembersMutex;
 
 public:
     Party(uint32_t partyId, uint32_t creator, const std::string& partyName);
     ~Party();
 
     uint32_t GetId() const { return m_PartyId; }
-    uint32_t GetPartyCreator() const { return m_PartyCreator; }
-    std::string GetName() const { return m_PartyName; }
+    uint32_t GetPartyCreator() const { return m_PartyCreator.load(); }
+    const std::string& GetName() const { return m_PartyName; }
     bool SetPartyName(const std::string& partyName) { m_PartyName = partyName; }
-    const std::vector<uint32_t>& GetMembers() const;
+    std::vector<PartyMember> GetMembers() const;
+    size_t GetMemberCount() const;
+
+    template<typename Func>
+    void ForEachMember(Func&& func) const
+    {
+        std::scoped_lock lock(m_MembersMutex);
+        for (const auto& member : m_Members)
+        {
+            func(member);
+        }
+    }
 
-    bool AddMember(uint32_t userId);
+    bool AddMember(const std::shared_ptr<UserSession>& user);
     bool HasMember(uint32_t userId) const;
     bool RemoveMember(uint32_t userId);
+    std::shared_ptr<UserSession> PromoteNextLeader();
     
     void PrintMembers() const;
 };
\ No newline at end of file
@@ -5,8 +5,29 @@
 class PartyManager
 {
 private:
-	uint32_t									            m_PartyIdCounter = 100'000;
-    std::unordered_map<uint32_t, std::shared_ptr<Party>>    m_MapParties;
+    static constexpr size_t SHARD_COUNT = 16;    // 잠금 경합을 나누기 위한 샤드 수
+
+    // 파티 ID 기준 샤드
+    struct PartyShard
+    {
+        std::mutex                                              mutex;
+        std::unordered_map<uint32_t, std::shared_ptr<Party>>    parties;
+    };
+
+    // 파티 이름 기준 샤드 (이름 중복 검사와 이름 조회용 인덱스)
+    struct NameShard
+    {
+        std::mutex                                              mutex;
+        std::unordered_map<std::string, std::shared_ptr<Party>> parties;
+    };
+
+    std::atomic<uint32_t>                                   m_PartyIdCounter = 100'000;
+    std::atomic<size_t>                                     m_PartyCount = 0;
+    std::array<PartyShard, SHARD_COUNT>                     m_PartyShards;
+    std::array<NameShard, SHARD_COUNT>                      m_NameShards;      // 이름 샤드 -> ID 샤드 순서로만 잠금
+
+    PartyShard& GetPartyShard(uint32_t partyId);
+    NameShard& GetNameShard(const std::string& partyName);
 
 public:
     PartyManager();
@@ -16,6 +37,7 @@ public:
     std::shared_ptr<Party> JoinParty(std::shared_ptr<UserSession> user, const std::string& partyName);
     uint32_t DeleteParty(std::shared_ptr<UserSession> user, const std::string& partyName);
     bool LeaveParty(std::shared_ptr<UserSession> user, const std::string& partyName);
+    std::shared_ptr<UserSession> RemoveDisconnectedMember(const std::shared_ptr<UserSession>& user);
     bool HasParty(uint32_t partyId);
     std::shared_ptr<Party> FindPartyById(uint32_t partyId);
     std::shared_ptr<Party> FindPartyByName(const std::string& partyName); 
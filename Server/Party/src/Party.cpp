@@ -1,4 +1,5 @@
 #include "Party/include/Party.h"
+#include "User/include/UserSession.h"
 #include <Util/HsLogger.hpp>
 
 Party::Party(uint32_t partyId, uint32_t creator, const std::string& partyName) :
@@ -6,7 +7,7 @@ Party::Party(uint32_t partyId, uint32_t creator, const std::string& partyName) :
     m_PartyCreator(creator),
     m_PartyName(partyName)
 {
-    LOG_INFO("Party Created: ID=%d, Creator=%d, Name=%s", m_PartyId, m_PartyCreator, m_PartyName.c_str());
+    LOG_INFO("Party Created: ID=%d, Creator=%d, Name=%s", m_PartyId, m_PartyCreator.load(), m_PartyName.c_str());
 }
 
 Party::~Party()
@@ -15,9 +16,23 @@ Party::~Party()
     m_Members.clear(); // 파티 멤버들을 모두 제거하여 정리
 }
 
-bool Party::AddMember(uint32_t userId)
+bool Party::AddMember(const std::shared_ptr<UserSession>& user)
 {
-    m_Members.push_back(userId); // 파티 멤버 추가
+    uint32_t userId = user->GetId();
+    {
+        std::scoped_lock lock(m_MembersMutex);
+        auto it = std::find_if(m_Members.begin(), m_Members.end(),
+            [&](const PartyMember& member)
+            {
+                return member.id == userId;
+            });
+        if (it != m_Members.end())
+        {
+            return false; // 이미 파티 멤버인 경우
+        }
+
+        m_Members.push_back({ userId, user }); // 파티 멤버 추가 (세션은 약한 참조로 보관하여 연결 종료 시 자동으로 무효화)
+    }
     LOG_INFO("Add Member in Party %s: %d", m_PartyName.c_str(), userId);
     PrintMembers(); // 현재 파티 멤버 목록 출력
     return true;
@@ -25,39 +40,76 @@ bool Party::AddMember(uint32_t userId)
 
 bool Party::RemoveMember(uint32_t userId)
 {
-    m_Members.erase(std::remove_if(m_Members.begin(), m_Members.end(),
-        [&](uint32_t sid)
-        {
-            return sid == userId; // 조건에 맞는 멤버 제거
-        }),
-        m_Members.end());
+    {
+        std::scoped_lock lock(m_MembersMutex);
+        m_Members.erase(std::remove_if(m_Members.begin(), m_Members.end(),
+            [&](const PartyMember& member)
+            {
+                return member.id == userId; // 조건에 맞는 멤버 제거
+            }),
+            m_Members.end());
+    }
 
     LOG_INFO("Remove Member in Party %s: %d", m_PartyName.c_str(), userId);
     PrintMembers(); // 현재 파티 멤버 목록 출력
     return true;
 }
 
+// 남아 있는 멤버 중 연결된 세션을 새 파티장으로 지정 (연결된 멤버가 없으면 첫 번째 멤버)
+std::shared_ptr<UserSession> Party::PromoteNextLeader()
+{
+    std::scoped_lock lock(m_MembersMutex);
+    if (m_Members.empty())
+    {
+        return nullptr;
+    }
+
+    for (const auto& member : m_Members)
+    {
+        auto session = member.session.lock();
+        if (session != nullptr && session->IsConnected())
+        {
+            m_PartyCreator = member.id;
+            LOG_INFO("Party %s leader changed: %d", m_PartyName.c_str(), member.id);
+            return session;
+        }
+    }
+
+    m_PartyCreator = m_Members.front().id;
+    LOG_INFO("Party %s leader changed: %d", m_PartyName.c_str(), m_Members.front().id);
+    return nullptr;
+}
+
 void Party::PrintMembers() const
 {
     std::stringstream ss;
     ss << "Member List: ";
+    std::scoped_lock lock(m_MembersMutex);
     for (auto it = m_Members.begin(); it != m_Members.end(); it++)
     {
-        ss << *it << " "; // 파티 멤버 목록 출력
+        ss << it->id << " "; // 파티 멤버 목록 출력
     }
     LOG_INFO("%s", ss.str().c_str());
 }
 
-const std::vector<uint32_t>& Party::GetMembers() const
+std::vector<PartyMember> Party::GetMembers() const
+{
+    std::scoped_lock lock(m_MembersMutex);
+    return m_Members; // 다른 스레드에서 변경될 수 있으므로 파티 멤버들의 복사본 반환
+}
+
+size_t Party::GetMemberCount() const
 {
-    return m_Members; // 파티 멤버들의 const 참조 반환
+    std::scoped_lock lock(m_MembersMutex);
+    return m_Members.size();
 }
 
 bool Party::HasMember(uint32_t sessionId) const
 {
+    std::scoped_lock lock(m_MembersMutex);
     return std::any_of(m_Members.begin(), m_Members.end(),
-        [&](uint32_t sid)
+        [&](const PartyMember& member)
         {
-            return sid == sessionId; // 특정 사용자가 파티 멤버인지 확인
+            return member.id == sessionId; // 특정 사용자가 파티 멤버인지 확인
         });
 }
\ No newline at end of file
@@ -8,7 +8,25 @@ PartyManager::PartyManager()
 
 PartyManager::~PartyManager()
 {
-    m_MapParties.clear(); // 모든 파티 맵 초기화
+    // 모든 파티 맵 초기화
+    for (auto& shard : m_PartyShards)
+    {
+        shard.parties.clear();
+    }
+    for (auto& shard : m_NameShards)
+    {
+        shard.parties.clear();
+    }
+}
+
+PartyManager::PartyShard& PartyManager::GetPartyShard(uint32_t partyId)
+{
+    return m_PartyShards[partyId % SHARD_COUNT];
+}
+
+PartyManager::NameShard& PartyManager::GetNameShard(const std::string& partyName)
+{
+    return m_NameShards[std::hash<std::string>{}(partyName) % SHARD_COUNT];
 }
 
 std::shared_ptr<Party> PartyManager::CreateParty(std::shared_ptr<UserSession> user, const std::string& partyName)
@@ -19,76 +37,110 @@ std::shared_ptr<Party> PartyManager::CreateParty(std::shared_ptr<UserSession> us
         return nullptr;
     }
 
-    auto party = std::make_shared<Party>(m_PartyIdCounter++, user->GetId(), partyName); // 파티 생성
-    party->AddMember(user->GetId());                                                    // 파티 생성자를 파티 멤버로 추가
-    m_MapParties[party->GetId()] = party;                                               // 파티를 맵에 추가
+    // 이름 샤드를 잡은 채로 생성하여 같은 이름의 동시 생성을 막음
+    auto& nameShard = GetNameShard(partyName);
+    std::scoped_lock nameLock(nameShard.mutex);
+
+    // 같은 이름의 파티가 이미 있으면 생성하지 않음
+    auto [it, inserted] = nameShard.parties.try_emplace(partyName, nullptr);
+    if (!inserted)
+    {
+        LOG_WARN("Party name already taken: %s", partyName.c_str());
+        return nullptr;
+    }
 
-    LOG_INFO("Party Count : %zu", m_MapParties.size());
+    auto party = std::make_shared<Party>(m_PartyIdCounter.fetch_add(1), user->GetId(), partyName);  // 파티 생성
+    party->AddMember(user);                                                                         // 파티 생성자를 파티 멤버로 추가
+    {
+        auto& partyShard = GetPartyShard(party->GetId());
+        std::scoped_lock partyLock(partyShard.mutex);
+        partyShard.parties[party->GetId()] = party;                                                 // 파티를 맵에 추가
+    }
+    it->second = party;                                                                             // 이름 인덱스에 추가
+
+    LOG_INFO("Party Count : %zu", ++m_PartyCount);
     return party;
 }
 
 std::shared_ptr<Party> PartyManager::JoinParty(std::shared_ptr<UserSession> user, const std::string& partyName)
 {
-    auto party = FindPartyByName(partyName);
-    if (!party)
+    // 삭제/해산과 겹쳐 이미 사라진 파티에 들어가지 않도록 이름 샤드를 잡고 처리
+    auto& nameShard = GetNameShard(partyName);
+    std::scoped_lock nameLock(nameShard.mutex);
+
+    auto it = nameShard.parties.find(partyName);
+    if (it == nameShard.parties.end() || !it->second)
     {
         LOG_INFO("Not found party: %s", partyName.c_str());
         return nullptr;
     }
 
-    party->AddMember(user->GetId()); // 파티에 사용자 추가
+    auto party = it->second;
+    party->AddMember(user); // 파티에 사용자 추가
     LOG_INFO("User %u joined party %s", user->GetId(), partyName.c_str());
     return party;
 }
 
 uint32_t PartyManager::DeleteParty(std::shared_ptr<UserSession> user, const std::string& partyName)
 {
+    auto& nameShard = GetNameShard(partyName);
+    std::scoped_lock nameLock(nameShard.mutex);
+
     // 파티 이름으로 파티를 찾음
-    auto party = FindPartyByName(partyName);
-    if (!party)
+    auto it = nameShard.parties.find(partyName);
+    if (it == nameShard.parties.end() || !it->second)
     {
-        std::cout << "[SERVER] Not found party: " << partyName << std::endl;
         LOG_INFO("Not found party: %s", partyName.c_str());
         return 0;
     }
 
+    auto party = it->second;
     auto partyId = party->GetId();
 
     // 파티 생성자인 경우에만 파티 삭제 가능
-    if (party->GetPartyCreator() == user->GetId())
+    if (party->GetPartyCreator() != user->GetId())
     {
-        LOG_INFO("Attempting to delete party with ID: %u", partyId);
-
-        size_t erasedCount = m_MapParties.erase(partyId);
-        LOG_INFO("Number of parties erased: %zu", erasedCount);
+        LOG_WARN("[SERVER] Fail Deleted Party : %s", partyName.c_str());
+        return 0;
+    }
 
-        if (erasedCount == 0)
-        {
-            LOG_ERROR("Failed to delete party with ID: %u. ID not found in m_MapParties.", partyId);
-            return 0;
-        }
+    LOG_INFO("Attempting to delete party with ID: %u", partyId);
 
-        LOG_INFO("[SERVER] Deleted party: %s", partyName.c_str());
+    size_t erasedCount = 0;
+    {
+        auto& partyShard = GetPartyShard(partyId);
+        std::scoped_lock partyLock(partyShard.mutex);
+        erasedCount = partyShard.parties.erase(partyId);
     }
-    else
+    nameShard.parties.erase(it);
+    LOG_INFO("Number of parties erased: %zu", erasedCount);
+
+    if (erasedCount == 0)
     {
-        LOG_WARN("[SERVER] Fail Deleted Party : %s", partyName.c_str());
+        LOG_ERROR("Failed to delete party with ID: %u. ID not found in party shards.", partyId);
         return 0;
     }
 
-    LOG_INFO("Party Count : %zu", m_MapParties.size());
+    LOG_INFO("[SERVER] Deleted party: %s", partyName.c_str());
+    LOG_INFO("Party Count : %zu", --m_PartyCount);
     return partyId;
 }
 
 bool PartyManager::LeaveParty(std::shared_ptr<UserSession> user, const std::string& partyName)
 {
-    auto party = FindPartyByName(partyName);
-    if (!party)
+    // 파티장 확인과 멤버 제거 사이에 파티장 위임/해산이 끼어들지 않도록 이름 샤드를 잡고 처리
+    auto& nameShard = GetNameShard(partyName);
+    std::scoped_lock nameLock(nameShard.mutex);
+
+    auto it = nameShard.parties.find(partyName);
+    if (it == nameShard.parties.end() || !it->second)
     {
         LOG_INFO("[SERVER] Not found party: %s", partyName.c_str());
         return false;
     }
 
+    auto party = it->second;
+
     // 파티 생성자는 파티를 떠날 수 없음
     if (party->GetPartyCreator() == user->GetId())
     {
@@ -101,15 +153,66 @@ bool PartyManager::LeaveParty(std::shared_ptr<UserSession> user, const std::stri
     return true;
 }
 
+// 연결이 끊긴(또는 중복 로그인으로 교체된) 세션을 파티에서 제거하는 함수
+// 파티장이었다면 남은 멤버에게 파티장을 넘기고, 남은 멤버가 없으면 파티를 해산
+// 새 파티장의 세션을 반환 (파티장이 바뀌지 않았거나 연결된 멤버가 없으면 nullptr)
+std::shared_ptr<UserSession> PartyManager::RemoveDisconnectedMember(const std::shared_ptr<UserSession>& user)
+{
+    auto party = FindPartyById(user->GetPartyId());
+    if (!party)
+    {
+        return nullptr;
+    }
+
+    // 삭제/파티장 변경과 겹치지 않도록 이름 샤드를 잡고 처리
+    auto& nameShard = GetNameShard(party->GetName());
+    std::scoped_lock nameLock(nameShard.mutex);
+
+    auto it = nameShard.parties.find(party->GetName());
+    if (it == nameShard.parties.end() || it->second != party)
+    {
+        return nullptr; // 이미 삭제된 파티
+    }
+
+    party->RemoveMember(user->GetId());
+
+    // 남은 멤버가 없으면 파티 해산
+    if (party->GetMemberCount() == 0)
+    {
+        {
+            auto& partyShard = GetPartyShard(party->GetId());
+            std::scoped_lock partyLock(partyShard.mutex);
+            partyShard.parties.erase(party->GetId());
+        }
+        nameShard.parties.erase(it);
+
+        LOG_INFO("[SERVER] Dissolved empty party: %s", party->GetName().c_str());
+        LOG_INFO("Party Count : %zu", --m_PartyCount);
+        return nullptr;
+    }
+
+    // 파티장이 나간 경우 다음 멤버에게 파티장 위임
+    if (party->GetPartyCreator() == user->GetId())
+    {
+        return party->PromoteNextLeader();
+    }
+
+    return nullptr;
+}
+
 bool PartyManager::HasParty(uint32_t partyId)
 {
-    return m_MapParties.find(partyId) != m_MapParties.end();
+    auto& shard = GetPartyShard(partyId);
+    std::scoped_lock lock(shard.mutex);
+    return shard.parties.find(partyId) != shard.parties.end();
 }
 
 std::shared_ptr<Party> PartyManager::FindPartyById(uint32_t partyId)
 {
-    auto it = m_MapParties.find(partyId);
-    if (it != m_MapParties.end())
+    auto& shard = GetPartyShard(partyId);
+    std::scoped_lock lock(shard.mutex);
+    auto it = shard.parties.find(partyId);
+    if (it != shard.parties.end())
     {
         return it->second;
     }
@@ -121,24 +224,22 @@ std::shared_ptr<Party> PartyManager::FindPartyById(uint32_t partyId)
 
 std::shared_ptr<Party> PartyManager::FindPartyByName(const std::string& partyName)
 {
-    for (const auto& entry : m_MapParties)
+    auto& shard = GetNameShard(partyName);
+    std::scoped_lock lock(shard.mutex);
+    auto it = shard.parties.find(partyName);
+    if (it != shard.parties.end())
     {
-        if (entry.second->GetName() == partyName)
-        {
-            return entry.second;
-        }
+        return it->second;
+    }
+    else
+    {
+        return nullptr;
     }
-    return nullptr;
 }
 
 bool PartyManager::IsPartyNameTaken(const std::string& partyName)
 {
-    for (const auto& pair : m_MapParties)
-    {
-        if (pair.second->GetName() == partyName)
-        {
-            return true;
-        }
-    }
-    return false;
+    auto& shard = GetNameShard(partyName);
+    std::scoped_lock lock(shard.mutex);
+    return shard.parties.find(partyName) != shard.parties.end();
 }
\ No newline at end of file
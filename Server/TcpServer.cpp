@@ -8,7 +8,10 @@ TcpServer::TcpServer(boost::asio::io_context& io_context, int port, std::unique_
 	, m_PartyManager(std::make_unique<PartyManager>())
 	, m_RedisClient(std::move(redisClient))
 	, m_MySQLConnector(std::move(mysqlManager))
+	, m_UserCache(std::make_unique<UserCache>(USER_CACHE_CAPACITY, USER_CACHE_TTL))
+	, m_FriendGraph(std::make_unique<FriendGraph>(*m_MySQLConnector))
 	, m_ThreadPool(threadPool)
+	, m_LastStatsLogTime(std::chrono::steady_clock::now())
 {
 }
 
@@ -27,6 +30,12 @@ TcpServer::~TcpServer()
 			m_ContextThread.join();
 		}
 
+		// 세션 I/O 스레드 풀 정리
+		if (m_IoContextPool)
+		{
+			m_IoContextPool->Stop();
+		}
+
 		// 사용자 세션들을 정리
 		RemoveUserSessions();
 		RemoveNewUserSessions();
@@ -37,16 +46,22 @@ TcpServer::~TcpServer()
 		LOG_ERROR("Exception in destructor: ", e.what());
 	}
 
+	// 종료 시점의 서버 상태 출력
+	LogServerStats();
+
 	// 서버 종료 메시지 출력
 	LOG_INFO("Shutdown Complete!");
 }
 
 // 서버 시작 함수
-bool TcpServer::Start(uint32_t maxUser /* = 3 */)
+bool TcpServer::Start(uint32_t maxUser /* = 3 */, size_t ioThreadCount /* = 0 */)
 {
 	try
 	{
 		m_MaxUser = maxUser;
+		// 유저 세션이 사용할 I/O 컨텍스트 풀 생성 및 실행
+		m_IoContextPool = std::make_unique<IoContextPool>(ioThreadCount);
+		m_IoContextPool->Run();
 		// 클라이언트 연결을 기다리는 함수 호출
 		WaitForClientConnection();
 		// IoContext를 실행하는 스레드 시작
@@ -60,22 +75,37 @@ bool TcpServer::Start(uint32_t maxUser /* = 3 */)
 	}
 
 	// 서버 시작 완료 메시지 출력
-	LOG_INFO("Tcp Server Start!! Max User : %d", m_MaxUser);
+	LOG_INFO("Tcp Server Start!! Max User : %d, IO Thread : %zu", m_MaxUser, m_IoContextPool->Size());
 	return true;
 }
 
 // 작업을 스레드 풀에 추가하는 함수
-void TcpServer::EnqueueJob(std::function<void()>&& task)
+void TcpServer::EnqueueJob(HSTask&& task)
 {
-	// ThreadPool의 EnqueueJob 함수 호출
-	m_ThreadPool.EnqueueJob(std::move(task));
+	// 로그인 검증은 지연에 민감하므로 다른 DB 작업보다 먼저 처리되도록 High 우선순위로 전달 (future 없음)
+	m_ThreadPool.PostJob(JobOptions{ JobPriority::High }, std::move(task));
+}
+
+// 다른 스레드에서 처리 루프로 후속 작업을 넘기는 함수
+void TcpServer::PostToDispatch(HSTask&& task)
+{
+	{
+		std::scoped_lock lock(m_DispatchMutex);
+		m_DispatchJobs.push_back(std::move(task));
+	}
+	m_DispatchCV.notify_one();
 }
 
 // 클라이언트 연결을 기다리는 함수
 void TcpServer::WaitForClientConnection()
 {
-	// UserSession 객체를 shared_ptr로 생성
-	auto user = std::make_shared<UserSession>(m_IoContext);
+	// UserSession 객체를 shared_ptr로 생성 (세션은 I/O 컨텍스트 풀에 라운드로빈으로 분배)
+	auto user = std::make_shared<UserSession>(m_IoContextPool->GetNextIoContext());
+	// 메시지 수신 및 연결 종료 시 처리 루프를 깨우도록 핸들러 등록
+	user->SetDispatchHandler([this](std::shared_ptr<UserSession> session)
+		{
+			this->NotifyDispatch(std::move(session));
+		});
 	// Acceptor를 이용하여 비동기적으로 클라이언트 연결을 받음
 	m_Acceptor.async_accept(user->GetSocket(),
 		[this, user](const boost::system::error_code& err)
@@ -109,90 +139,193 @@ void TcpServer::UpdateUsers()
 {
 	std::scoped_lock lock(m_UsersMutex, m_NewUsersMutex);
 
-	// 연결되지 않은 사용자 세션을 제거
-	m_Users.erase(std::remove_if(m_Users.begin(), m_Users.end(), [](auto& user)
-		{
-			if (!user->IsConnected())
-			{
-				user->Close();
-				return true;
-			}
-			return false;
-		}), m_Users.end());
-
-	// 새로운 사용자 세션을 기존 사용자 목록에 추가
-	while (!m_NewUsers.empty() && m_Users.size() < m_MaxUser)
+	// 로그인 메시지를 보낸 대기 세션을 모아 한 번에 스레드 풀에 맡김
+	// (메시지가 없는 세션은 큐 뒤로 다시 들어가므로 이번 호출에서는 현재 대기 중인 수만큼만 확인)
+	std::vector<VerifyRequest> requests;
+	size_t pendingCount = m_NewUsers.size();
+	while (pendingCount-- > 0 && m_Users.size() + m_VerifyingUserCount < m_MaxUser)
 	{
 		auto user = m_NewUsers.front();
 		m_NewUsers.pop();
 
-		auto msg = user->GetMessageInUserQueue();
+		// 로그인 전에 연결이 끊긴 세션은 대기열에서 제거
+		if (!user->IsConnected())
+		{
+			continue;
+		}
+
+		// 대기 중인 세션은 처리 루프가 아닌 이곳에서 메시지를 소비하므로 알림 상태 초기화
+		user->ResetDispatchRequest();
 
-		if (msg && VerifyUser(user, msg->content()))
+		auto msg = user->GetMessageInUserQueue();
+		if (!msg)
 		{
-			auto userID = user->GetId();
-			// 중복 로그인 체크 후 처리
-			auto it = std::find_if(m_Users.begin(), m_Users.end(), [&](const auto& existingUser)
-				{
-					return existingUser->GetId() == userID;
-				});
+			m_NewUsers.push(std::move(user));
+			continue;
+		}
+
+		++m_VerifyingUserCount;
+		requests.push_back({ std::move(user), msg->content() });
+	}
 
-			if (it != m_Users.end())
+	if (requests.empty())
+	{
+		return;
+	}
+
+	// Redis/MySQL 조회는 처리 루프를 막지 않도록 스레드 풀에서 수행하고, 결과만 처리 루프로 전달
+	EnqueueJob([this, requests = std::move(requests)]()
+		{
+			auto results = VerifyUsers(requests);
 			{
-				// 중복 로그인 시 기존 사용자 처리
-				SendServerMessage(*it, "Logged out due to duplicate login.");
-				(*it)->Close();
-				m_Users.erase(it);
+				std::scoped_lock lock(m_DispatchMutex);
+				m_VerifiedUsers.insert(m_VerifiedUsers.end(), std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
 			}
+			m_DispatchCV.notify_one();
+		});
+}
 
-			// 새로운 사용자 세션을 목록에 추가하고 로그인 메시지 전송
-			m_Users.push_back(std::move(user));
-			SendLoginMessage(m_Users.back());
+// 검증이 끝난 세션을 사용자 목록에 추가하는 함수
+void TcpServer::AdmitVerifiedUsers(std::vector<VerifyResult>& verifiedUsers)
+{
+	std::scoped_lock lock(m_UsersMutex, m_NewUsersMutex);
+
+	for (auto& [user, userEntity] : verifiedUsers)
+	{
+		--m_VerifyingUserCount;
+
+		// 검증 중에 연결이 끊긴 세션은 버림
+		if (!user->IsConnected())
+		{
+			continue;
 		}
-		else
+
+		if (!userEntity)
 		{
 			// 유효하지 않은 사용자 세션은 다시 큐에 추가
 			m_NewUsers.push(std::move(user));
+			continue;
+		}
+
+		// UserSession 객체의 ID 설정 및 인증 상태 설정
+		user->SetID(userEntity->GetId());
+		user->SetUserEntity(userEntity);
+		user->SetVerified(true);
+
+		// 중복 로그인 체크 후 처리
+		auto existingUser = GetUserById(user->GetId());
+		if (existingUser)
+		{
+			// 중복 로그인 시 기존 사용자 처리
+			SendServerMessage(existingUser, "Logged out due to duplicate login.");
+			existingUser->Close();
+			RemoveUser(existingUser);
 		}
+
+		// 새로운 사용자 세션을 목록에 추가하고 로그인 메시지 전송
+		AddUser(user);
+		SendLoginMessage(user);
+
+		// 로그인 전에 쌓인 메시지가 있을 수 있으므로 처리 요청
+		user->RequestDispatch();
 	}
+
+	verifiedUsers.clear();
 }
 
-bool TcpServer::VerifyUser(std::shared_ptr<UserSession>& user, const std::string& sessionId)
+// 이번 틱에 모인 세션 키로 사용자들을 한 번에 검증하는 함수 (스레드 풀에서 실행, 실패한 세션의 엔티티는 nullptr)
+std::vector<TcpServer::VerifyResult> TcpServer::VerifyUsers(const std::vector<VerifyRequest>& requests)
 {
-	std::string sessionKey = "Session:" + sessionId;
-	std::string sessionValue;
+	std::vector<VerifyResult> results;
+	results.reserve(requests.size());
+	for (auto& request : requests)
+	{
+		results.push_back({ request.user, nullptr });
+	}
+
+	// 같은 세션 ID 는 한 번만 조회
+	std::vector<std::string> sessionKeys;
+	std::unordered_map<std::string, size_t> sessionKeyIndex;
+	std::vector<size_t> requestKeyIndex(requests.size());
+	for (size_t i = 0; i < requests.size(); ++i)
+	{
+		auto [it, inserted] = sessionKeyIndex.try_emplace("Session:" + requests[i].sessionId, sessionKeys.size());
+		if (inserted)
+		{
+			sessionKeys.push_back(it->first);
+		}
+		requestKeyIndex[i] = it->second;
+	}
 
 	try
 	{
-		// Redis에서 세션 정보 조회
-		if (m_RedisClient->Get(sessionKey, &sessionValue) != RC_SUCCESS)
+		// Redis에서 세션 정보를 MGET 한 번으로 조회 (없는 키는 빈 문자열)
+		std::vector<std::string> sessionValues;
+		if (m_RedisClient->Mget(sessionKeys, &sessionValues) != RC_SUCCESS || sessionValues.size() != sessionKeys.size())
 		{
-			// 세션 ID가 존재하지 않는 경우 처리
-			LOG_INFO("Not Found Session ID");
-			return false;
+			LOG_ERROR("Failed to get session values (%zu keys)", sessionKeys.size());
+			return results;
 		}
 
-		// 세션 정보 로깅
-		LOG_INFO("SessionKey : %s, SesseionValue : %s", sessionKey.c_str(), sessionValue.c_str());
+		// 유효한 세션 값의 사용자를 모아 MySQL에서 IN 쿼리 한 번으로 조회
+		// (다른 서버에서 바뀐 사용자 정보가 로그인에 반영되도록 캐시를 거치지 않고, 읽은 결과로 캐시를 갱신)
+		std::vector<std::string> userIds;
+		std::unordered_set<std::string> userIdSet;
+		std::unordered_map<uint32_t, std::shared_ptr<UserEntity>> userEntities;
+		for (auto& sessionValue : sessionValues)
+		{
+			if (!sessionValue.empty() && userIdSet.insert(sessionValue).second)
+			{
+				userIds.push_back(sessionValue);
+			}
+		}
 
-		// UserSession 객체의 ID 설정 및 인증 상태 설정
-		user->SetID(StringToUint32(sessionValue));
-		user->SetVerified(true);
+		if (!userIds.empty())
+		{
+			for (auto& userEntity : m_MySQLConnector->GetUsersByIds(userIds))
+			{
+				m_UserCache->Put(userEntity);
+				userEntities.emplace(userEntity->GetId(), userEntity);
+			}
+		}
 
-		// MySQL에서 해당 사용자 정보 조회
-		std::shared_ptr<UserEntity> userEntity = m_MySQLConnector->GetUserById(sessionValue);
-		user->SetUserEntity(userEntity);
+		for (size_t i = 0; i < requests.size(); ++i)
+		{
+			const std::string& sessionValue = sessionValues[requestKeyIndex[i]];
+			if (sessionValue.empty())
+			{
+				// 세션 ID가 존재하지 않는 경우 처리
+				LOG_INFO("Not Found Session ID");
+				continue;
+			}
+
+			uint32_t id = 0;
+			try
+			{
+				id = StringToUint32(sessionValue);
+			}
+			catch (const std::exception&)
+			{
+				continue;
+			}
 
-		return true;
+			auto it = userEntities.find(id);
+			if (it != userEntities.end())
+			{
+				// 같은 계정으로 동시에 들어온 세션이 엔티티를 공유하지 않도록 복사
+				results[i].userEntity = std::make_shared<UserEntity>(*it->second);
+			}
+		}
+
+		LOG_INFO("Verified login batch : %zu requests, %zu sessions, %zu users", requests.size(), sessionKeys.size(), userEntities.size());
 	}
 	catch (const std::exception& e)
 	{
 		// 예외 발생 시 처리
 		LOG_ERROR("Exception occurred : %s", e.what());
-		return false;
 	}
 
-	return true;
+	return results;
 }
 
 void TcpServer::RemoveUserSessions()
@@ -200,7 +333,7 @@ void TcpServer::RemoveUserSessions()
 	std::scoped_lock lock(m_UsersMutex);
 
 	// 모든 연결된 사용자 세션을 닫고, m_Users 컨테이너를 비웁니다.
-	for (auto& user : m_Users)
+	for (auto& [id, user] : m_Users)
 	{
 		if (user && user->IsConnected())
 		{
@@ -209,6 +342,7 @@ void TcpServer::RemoveUserSessions()
 	}
 
 	m_Users.clear();
+	m_UsersByUserId.clear();
 }
 
 
@@ -225,39 +359,143 @@ void TcpServer::RemoveNewUserSessions()
 
 void TcpServer::Update()
 {
+	std::vector<std::shared_ptr<UserSession>> readyUsers;
+	std::vector<VerifyResult> verifiedUsers;
+	std::vector<HSTask> dispatchJobs;
+
 	while (1)
 	{
+		{
+			// 메시지나 로그인 검증 결과가 도착할 때까지 대기 (이벤트가 없어도 주기적으로 깨어나 세션 정리)
+			std::unique_lock<std::mutex> lock(m_DispatchMutex);
+			m_DispatchCV.wait_for(lock, DISPATCH_IDLE_TIMEOUT, [this]() { return !m_ReadyUsers.empty() || !m_VerifiedUsers.empty() || !m_DispatchJobs.empty(); });
+			readyUsers.swap(m_ReadyUsers);
+			verifiedUsers.swap(m_VerifiedUsers);
+			dispatchJobs.swap(m_DispatchJobs);
+		}
+
+		// 검증이 끝난 세션 로그인 처리
+		AdmitVerifiedUsers(verifiedUsers);
+
 		// 사용자 세션 업데이트
 		UpdateUsers();
 
-		if (m_Users.empty())
+		// 스레드 풀에서 끝난 DB 작업의 후속 처리
+		for (auto& job : dispatchJobs)
 		{
-			continue;
+			job();
 		}
+		dispatchJobs.clear();
 
-		// 모든 연결된 사용자 세션에 대해 메시지 처리
-		for (auto u : m_Users)
+		// 메시지가 도착한 사용자 세션만 처리
+		for (auto& u : readyUsers)
 		{
-			if (u == nullptr || !u->IsConnected())
+			if (u == nullptr || !u->GetVerified())
 			{
 				continue;
 			}
 
-			// 사용자로부터 수신된 메시지 처리
-			while (true)
+			// 연결이 끊긴 사용자 세션은 목록에서 제거
+			if (!u->IsConnected())
 			{
-				auto msg = u->GetMessageInUserQueue();
-				if (!msg)
-				{
-					break;
-				}
-
-				OnMessage(u, msg);
+				RemoveUser(u);
+				continue;
 			}
+
+			DispatchUserMessages(u);
+		}
+
+		readyUsers.clear();
+
+		// 주기적으로 서버 상태 기록
+		auto now = std::chrono::steady_clock::now();
+		if (now - m_LastStatsLogTime >= STATS_LOG_INTERVAL)
+		{
+			m_LastStatsLogTime = now;
+			LogServerStats();
 		}
 	}
 }
 
+// 스레드 풀, 메시지/프레임 풀의 상태를 로그로 남기는 함수
+void TcpServer::LogServerStats()
+{
+	// 스레드 풀 큐 깊이와 작업별 대기/실행 시간 분포 (백분위는 2의 거듭제곱 구간의 상한값)
+	auto poolStats = m_ThreadPool.GetStats();
+	LOG_INFO("Thread pool : workers %zu, busy %zu, queued %zu, peak queued %zu, completed %llu", poolStats.workerCount, poolStats.busyWorkers, poolStats.queueDepth, poolStats.peakQueueDepth, poolStats.completedJobs);
+	LOG_INFO("Thread pool : wait p50 %lluus, p99 %lluus, run p50 %lluus, p99 %lluus", poolStats.waitP50Us, poolStats.waitP99Us, poolStats.runP50Us, poolStats.runP99Us);
+
+	// 스레드 풀 우선순위별 큐 대기 시간
+	const char* laneNames[] = { "High", "Normal", "Low" };
+	for (size_t i = 0; i < static_cast<size_t>(JobPriority::Count); ++i)
+	{
+		auto laneStats = m_ThreadPool.GetLaneStats(static_cast<JobPriority>(i));
+		uint64_t avgWaitUs = laneStats.executedCount ? laneStats.totalWaitUs / laneStats.executedCount : 0;
+		LOG_INFO("Job lane %s : executed %llu, expired %llu, avg wait %lluus, max wait %lluus", laneNames[i], laneStats.executedCount, laneStats.expiredCount, avgWaitUs, laneStats.maxWaitUs);
+	}
+
+	// 처리 루프가 따라오지 못해 수신 큐가 넘쳐 종료된 세션 수
+	LOG_INFO("Inbound queue : sessions closed by overflow %llu", UserSession::GetInboundOverflowCount());
+
+	// 사용자 캐시 적중률 (접속 중인 세션 또는 캐시된 조회 결과로 응답한 비율)
+	auto cacheStats = m_UserCache->GetStats();
+	uint64_t cacheLookups = cacheStats.onlineHitCount + cacheStats.hitCount + cacheStats.missCount;
+	double cacheHitRate = cacheLookups ? 100.0 * (cacheStats.onlineHitCount + cacheStats.hitCount) / cacheLookups : 0.0;
+	LOG_INFO("User cache : online hits %llu, hits %llu, misses %llu (hit rate %.1f%%), evictions %llu, online %zu, cached %zu",
+		cacheStats.onlineHitCount, cacheStats.hitCount, cacheStats.missCount, cacheHitRate, cacheStats.evictionCount, cacheStats.onlineCount, cacheStats.cachedCount);
+
+	// 동시 조회 합치기 현황 (공유받은 수만큼 DB 쿼리가 줄어듦)
+	auto userLookupStats = m_UserLookupFlight.GetStats();
+	LOG_INFO("Single flight : user lookup executed %llu, shared %llu", userLookupStats.executedCount, userLookupStats.sharedCount);
+
+	// 친구 관계 그래프 현황 (DB 에서 읽어온 수 대비 메모리에서 응답한 수)
+	auto friendGraphStats = m_FriendGraph->GetStats();
+	LOG_INFO("Friend graph : loads %llu, hits %llu, loaded users %zu", friendGraphStats.loadCount, friendGraphStats.hitCount, friendGraphStats.loadedUserCount);
+
+	// 메시지/프레임 풀의 재사용 현황 (새로 할당한 수가 작을수록 메시지당 할당이 적음)
+	auto messageStats = ObjectPool<myChatMessage::ChatMessage>::Instance().GetStats();
+	auto frameStats = ObjectPool<std::vector<uint8_t>>::Instance().GetStats();
+	LOG_INFO("Message pool : acquired %llu, new objects %llu, new blocks %llu", messageStats.acquireCount, messageStats.objectAllocCount, messageStats.blockAllocCount);
+	LOG_INFO("Frame pool : acquired %llu, new objects %llu, new blocks %llu", frameStats.acquireCount, frameStats.objectAllocCount, frameStats.blockAllocCount);
+}
+
+
+void TcpServer::NotifyDispatch(std::shared_ptr<UserSession> user)
+{
+	{
+		std::scoped_lock lock(m_DispatchMutex);
+		m_ReadyUsers.push_back(std::move(user));
+	}
+
+	// 대기 중인 처리 루프를 깨움
+	m_DispatchCV.notify_one();
+}
+
+
+void TcpServer::DispatchUserMessages(std::shared_ptr<UserSession>& user)
+{
+	// 처리를 시작하기 전에 알림 상태를 초기화하여 이후 도착하는 메시지를 놓치지 않도록 함
+	user->ResetDispatchRequest();
+
+	// 한 세션이 처리 루프를 독점하지 않도록 정해진 개수만큼만 처리
+	for (size_t i = 0; i < DISPATCH_BATCH_SIZE; ++i)
+	{
+		auto msg = user->GetMessageInUserQueue();
+		if (!msg)
+		{
+			return;
+		}
+
+		OnMessage(user, msg);
+	}
+
+	// 남은 메시지는 다음 순회에서 처리
+	if (user->GetInboundQueueSize() > 0)
+	{
+		user->RequestDispatch();
+	}
+}
+
 
 void TcpServer::OnMessage(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg)
 {
@@ -417,22 +655,26 @@ void TcpServer::HandlePartyDelete(std::shared_ptr<UserSession> user, std::shared
 
 	LOG_INFO("Delete Party!");
 
+	// 삭제 후 멤버들의 파티 ID를 초기화하기 위해 파티를 미리 찾아 둠
+	auto party = m_PartyManager->FindPartyByName(msg->content());
+
 	// 파티 삭제 시도 및 실패 시 에러 메시지 전송 후 종료
 	auto partyId = m_PartyManager->DeleteParty(user, msg->content());
-	if (!partyId)
+	if (!partyId || !party)
 	{
 		SendErrorMessage(user, "Party delete Failed");
 		return;
 	}
 
-	// 해당 파티에 속한 모든 사용자의 파티 ID를 초기화
-	for (auto& u : m_Users)
-	{
-		if (u->GetPartyId() == partyId)
+	// 해당 파티에 속한 사용자들의 파티 ID만 초기화 (전체 사용자 목록을 순회하지 않음)
+	party->ForEachMember([partyId](const PartyMember& member)
 		{
-			u->SetPartyId(0);
-		}
-	}
+			auto session = member.session.lock();
+			if (session != nullptr && session->GetPartyId() == partyId)
+			{
+				session->SetPartyId(0);
+			}
+		});
 
 	// 파티 삭제 성공 메시지 전송
 	SendServerMessage(user, "Party delete successful");
@@ -508,93 +750,105 @@ void TcpServer::HandleWhisperMessage(std::shared_ptr<UserSession> user, std::sha
 
 void TcpServer::HandleFriendRequest(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg) {
 	try {
-		// 요청 유효성 검사를 비동기적으로 실행
-		auto validateFuture = ValidateRequest(user, msg);
-		validateFuture.get();
-
-		// 사용자의 존재 여부를 비동기적으로 확인
-		auto checkUserExistenceFuture = CheckUserExistence(msg->content());
-		auto receiveUser = checkUserExistenceFuture.get();
-
-		// 친구 요청 상태를 비동기적으로 확인
-		auto checkFriendRequestStatusFuture = CheckFriendRequestStatus(user, receiveUser);
-		checkFriendRequestStatusFuture.get();
-
-		// 친구 요청을 추가하는 작업을 비동기적으로 실행
-		auto addFriendRequestFuture = AddFriendRequest(user, receiveUser);
-		addFriendRequestFuture.get();
-
-		// 사용자들에게 알림을 보냄
-		NotifyUsers(user, receiveUser);
+		// 요청 유효성 검사 (DB 작업이 없으므로 바로 실행)
+		ValidateRequest(user, msg);
 	}
 	catch (const std::exception& e) {
 		// 예외 발생 시 에러 메시지를 전송
 		SendErrorMessage(user, e.what());
+		return;
 	}
-}
 
-
-std::future<void> TcpServer::ValidateRequest(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg) {
-	return m_ThreadPool.EnqueueJob([this, user, msg]()
+	// 사용자 확인, 요청 상태 확인, 요청 추가를 스레드 풀에서 이어서 실행하고 결과만 처리 루프에서 전송
+	EnqueueJobThen([this, user, receiveUserId = msg->content()]()
 		{
-			// 요청 내용이 비어 있으면 예외를 발생시킴
-			if (msg->content().empty())
-			{
-				throw std::runtime_error("The content of is empty.");
-			}
-			// 자기 자신에게 요청을 보내는 경우 예외를 발생시킴
-			if (user->GetUserEntity()->GetUserId() == msg->content())
-			{
-				throw std::runtime_error("You cannot send request to yourself.");
-			}
+			auto receiveUser = CheckUserExistence(receiveUserId);
+			// 같은 사용자 쌍의 요청 확인과 추가 사이에 다른 친구 작업이 끼어들지 않도록 잠금
+			std::scoped_lock pairLock(GetFriendPairMutex(user->GetId(), receiveUser->GetId()));
+			CheckFriendRequestStatus(user, receiveUser);
+			AddFriendRequest(user, receiveUser);
+			return receiveUser;
+		},
+		[this, user](std::shared_ptr<UserEntity> receiveUser)
+		{
+			// 사용자들에게 알림을 보냄
+			NotifyUsers(user, receiveUser);
+		},
+		[this, user](const std::string& error) mutable
+		{
+			// 예외 발생 시 에러 메시지를 전송
+			SendErrorMessage(user, error);
 		});
 }
 
-std::future<std::shared_ptr<UserEntity>> TcpServer::CheckUserExistence(const std::string& userId)
+
+void TcpServer::ValidateRequest(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg) {
+	// 요청 내용이 비어 있으면 예외를 발생시킴
+	if (msg->content().empty())
+	{
+		throw std::runtime_error("The content of is empty.");
+	}
+	// 자기 자신에게 요청을 보내는 경우 예외를 발생시킴
+	if (user->GetUserEntity()->GetUserId() == msg->content())
+	{
+		throw std::runtime_error("You cannot send request to yourself.");
+	}
+}
+
+// 스레드 풀에서 실행
+std::shared_ptr<UserEntity> TcpServer::CheckUserExistence(const std::string& userId)
 {
-	return m_ThreadPool.EnqueueJob([this, userId]() -> std::shared_ptr<UserEntity>
+	// 접속 중이거나 최근에 조회한 사용자는 캐시에서 바로 반환
+	auto receiveUser = m_UserCache->FindByUserId(userId);
+	if (receiveUser)
+	{
+		return receiveUser;
+	}
+
+	// 주어진 사용자 ID로 사용자를 검색하고, 존재하지 않으면 예외를 발생시킴
+	// (같은 사용자에게 요청이 몰리면 동시에 들어온 조회는 하나의 DB 쿼리 결과를 함께 사용)
+	receiveUser = m_UserLookupFlight.Do(userId, [this, &userId]()
 		{
-			// 주어진 사용자 ID로 사용자를 검색하고, 존재하지 않으면 예외를 발생시킴
 			std::vector<MySQLManager::Condition> conditions = { {"user_id", userId} };
-			auto receiveUser = m_MySQLConnector->GetUserByConditions(conditions);
-			if (!receiveUser)
-			{
-				throw std::runtime_error("User not found.");
-			}
-
-			return receiveUser;
+			auto dbUser = m_MySQLConnector->GetUserByConditions(conditions);
+			m_UserCache->Put(dbUser);
+			return dbUser;
 		});
-}
 
+	if (!receiveUser)
+	{
+		throw std::runtime_error("User not found.");
+	}
 
-std::future<void> TcpServer::CheckFriendRequestStatus(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser) {
-	return m_ThreadPool.EnqueueJob([this, user, receiveUser]()
-		{
-			// 요청자와 수신자 간에 이미 친구 요청이 있는지 확인하고, 있으면 예외를 발생시킴
-			auto requestId = std::to_string(user->GetId());
-			auto receiveId = std::to_string(receiveUser->GetId());
+	return receiveUser;
+}
 
-			if (m_MySQLConnector->HasFriendRequest(requestId, receiveId))
-			{
-				throw std::runtime_error("You have already sent a friend request to this user.");
-			}
-			if (m_MySQLConnector->HasFriendRequest(receiveId, requestId))
-			{
-				throw std::runtime_error("This user has already sent you a friend request.");
-			}
-		});
+
+// 스레드 풀에서 실행
+void TcpServer::CheckFriendRequestStatus(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser) {
+	// 요청자와 수신자 간에 이미 친구 요청이 있는지 확인하고, 있으면 예외를 발생시킴
+	// (요청자의 관계는 친구 그래프에 올라와 있으므로 DB 조회 없이 확인)
+	if (m_FriendGraph->HasSentRequest(user->GetId(), receiveUser->GetId()))
+	{
+		throw std::runtime_error("You have already sent a friend request to this user.");
+	}
+	if (m_FriendGraph->HasReceivedRequest(user->GetId(), receiveUser->GetId()))
+	{
+		throw std::runtime_error("This user has already sent you a friend request.");
+	}
 }
 
 
-std::future<void> TcpServer::AddFriendRequest(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser) {
-	return m_ThreadPool.EnqueueJob([this, user, receiveUser]()
-		{
-			// 친구 요청을 데이터베이스에 추가하고, 실패한 경우 예외를 발생시킴
-			if (!m_MySQLConnector->AddFriendRequest(std::to_string(user->GetId()), std::to_string(receiveUser->GetId())))
-			{
-				throw std::runtime_error("Failed to create friend request.");
-			}
-		});
+// 스레드 풀에서 실행
+void TcpServer::AddFriendRequest(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser) {
+	// 친구 요청을 데이터베이스에 추가하고, 실패한 경우 예외를 발생시킴
+	if (!m_MySQLConnector->AddFriendRequest(std::to_string(user->GetId()), std::to_string(receiveUser->GetId())))
+	{
+		throw std::runtime_error("Failed to create friend request.");
+	}
+
+	// DB 반영 후 친구 그래프에도 반영
+	m_FriendGraph->AddFriendRequest(user->GetId(), receiveUser->GetId());
 }
 
 
@@ -604,50 +858,61 @@ void TcpServer::HandleFriendAccept(std::shared_ptr<UserSession> user, std::share
 {
 	try
 	{
-		// 요청 유효성 검사를 비동기적으로 실행
-		auto validateFuture = ValidateRequest(user, msg);
-		validateFuture.get();
-
-		// 요청을 보낸 사용자의 존재 여부를 비동기적으로 확인
-		auto checkUserExistenceFuture = CheckUserExistence(msg->content());
-		auto sender = checkUserExistenceFuture.get();
-
-		// 친구 요청 수락 작업을 비동기적으로 실행
-		auto processFriendAcceptFuture = ProcessFriendAccept(user, sender);
-		processFriendAcceptFuture.get();
-
-		// 수락된 친구에게 알림을 보냄
-		NotifyAcceptUsers(user, sender);
+		// 요청 유효성 검사 (DB 작업이 없으므로 바로 실행)
+		ValidateRequest(user, msg);
 	}
 	catch (const std::exception& e) {
 		// 예외 발생 시 에러 메시지를 전송
 		SendErrorMessage(user, e.what());
+		return;
 	}
+
+	// 요청을 보낸 사용자 확인과 수락 처리를 스레드 풀에서 이어서 실행
+	EnqueueJobThen([this, user, senderId = msg->content()]()
+		{
+			auto sender = CheckUserExistence(senderId);
+			// 같은 요청을 동시에 수락해 친구 관계가 중복 생성되지 않도록 사용자 쌍 단위로 잠금
+			std::scoped_lock pairLock(GetFriendPairMutex(user->GetId(), sender->GetId()));
+			ProcessFriendAccept(user, sender);
+			return sender;
+		},
+		[this, user](std::shared_ptr<UserEntity> sender)
+		{
+			// 수락된 친구에게 알림을 보냄
+			NotifyAcceptUsers(user, sender);
+		},
+		[this, user](const std::string& error) mutable
+		{
+			// 예외 발생 시 에러 메시지를 전송
+			SendErrorMessage(user, error);
+		});
 }
 
 
 
-std::future<void> TcpServer::ProcessFriendAccept(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender)
+// 스레드 풀에서 실행
+void TcpServer::ProcessFriendAccept(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender)
 {
-	return m_ThreadPool.EnqueueJob([this, user, sender]()
-		{
-			try
-			{
-				// 트랜잭션 시작
-				m_MySQLConnector->BeginTransaction();
-				// 친구 관계를 업데이트하고, 친구 목록에 추가
-				m_MySQLConnector->UpdateFriend(std::to_string(sender->GetId()), std::to_string(user->GetId()), "A");
-				m_MySQLConnector->AddFriendship(std::to_string(sender->GetId()), std::to_string(user->GetId()));
-				// 트랜잭션 커밋
-				m_MySQLConnector->CommitTransaction();
-			}
-			catch (const std::exception&)
-			{
-				// 오류 발생 시 트랜잭션 롤백하고 예외 발생
-				m_MySQLConnector->RollbackTransaction();
-				throw std::runtime_error("Failed to process friend accept.");
-			}
-		});
+	try
+	{
+		// 트랜잭션 시작
+		m_MySQLConnector->BeginTransaction();
+		// 친구 관계를 업데이트하고, 친구 목록에 추가
+		m_MySQLConnector->UpdateFriend(std::to_string(sender->GetId()), std::to_string(user->GetId()), "A");
+		m_MySQLConnector->AddFriendship(std::to_string(sender->GetId()), std::to_string(user->GetId()));
+		// 트랜잭션 커밋
+		m_MySQLConnector->CommitTransaction();
+
+		// 커밋 후 친구 그래프에도 반영
+		m_FriendGraph->UpdateFriendRequest(sender->GetId(), user->GetId(), "A");
+		m_FriendGraph->AddFriendship(sender->GetId(), user->GetId());
+	}
+	catch (const std::exception&)
+	{
+		// 오류 발생 시 트랜잭션 롤백하고 예외 발생
+		m_MySQLConnector->RollbackTransaction();
+		throw std::runtime_error("Failed to process friend accept.");
+	}
 }
 
 
@@ -656,47 +921,57 @@ std::future<void> TcpServer::ProcessFriendAccept(std::shared_ptr<UserSession> us
 void TcpServer::HandleFriendReject(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg)
 {
 	try {
-		// 요청 유효성 검사를 비동기적으로 실행
-		auto validateFuture = ValidateRequest(user, msg);
-		validateFuture.get();
-
-		// 요청을 보낸 사용자의 존재 여부를 비동기적으로 확인
-		auto checkUserExistenceFuture = CheckUserExistence(msg->content());
-		auto sender = checkUserExistenceFuture.get();
-
-		// 친구 요청 거절 작업을 비동기적으로 실행
-		auto processFriendRejectFuture = ProcessFriendReject(user, sender);
-		processFriendRejectFuture.get();
-
-		// 거절된 친구에게 알림을 보냄
-		NotifyRejectUsers(user, sender);
+		// 요청 유효성 검사 (DB 작업이 없으므로 바로 실행)
+		ValidateRequest(user, msg);
 	}
 	catch (const std::exception& e) {
 		// 예외 발생 시 에러 메시지를 전송
 		SendErrorMessage(user, e.what());
+		return;
 	}
+
+	// 요청을 보낸 사용자 확인과 거절 처리를 스레드 풀에서 이어서 실행
+	EnqueueJobThen([this, user, senderId = msg->content()]()
+		{
+			auto sender = CheckUserExistence(senderId);
+			// 수락과 거절이 동시에 처리되지 않도록 사용자 쌍 단위로 잠금
+			std::scoped_lock pairLock(GetFriendPairMutex(user->GetId(), sender->GetId()));
+			ProcessFriendReject(user, sender);
+			return sender;
+		},
+		[this, user](std::shared_ptr<UserEntity> sender)
+		{
+			// 거절된 친구에게 알림을 보냄
+			NotifyRejectUsers(user, sender);
+		},
+		[this, user](const std::string& error) mutable
+		{
+			// 예외 발생 시 에러 메시지를 전송
+			SendErrorMessage(user, error);
+		});
 }
 
 
-std::future<void> TcpServer::ProcessFriendReject(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender)
+// 스레드 풀에서 실행
+void TcpServer::ProcessFriendReject(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender)
 {
-	return m_ThreadPool.EnqueueJob([this, user, sender]()
-		{
-			try
-			{
-				// 트랜잭션 시작
-				m_MySQLConnector->BeginTransaction();
-				// 친구 요청을 삭제하고, 트랜잭션 커밋
-				m_MySQLConnector->DeleteFriendRequest(std::to_string(sender->GetId()), std::to_string(user->GetId()));
-				m_MySQLConnector->CommitTransaction();
-			}
-			catch (const std::exception&)
-			{
-				// 오류 발생 시 트랜잭션 롤백하고 예외 발생
-				m_MySQLConnector->RollbackTransaction();
-				throw std::runtime_error("Failed to process friend reject.");
-			}
-		});
+	try
+	{
+		// 트랜잭션 시작
+		m_MySQLConnector->BeginTransaction();
+		// 친구 요청을 삭제하고, 트랜잭션 커밋
+		m_MySQLConnector->DeleteFriendRequest(std::to_string(sender->GetId()), std::to_string(user->GetId()));
+		m_MySQLConnector->CommitTransaction();
+
+		// 커밋 후 친구 그래프에도 반영
+		m_FriendGraph->RemoveFriendRequest(sender->GetId(), user->GetId());
+	}
+	catch (const std::exception&)
+	{
+		// 오류 발생 시 트랜잭션 롤백하고 예외 발생
+		m_MySQLConnector->RollbackTransaction();
+		throw std::runtime_error("Failed to process friend reject.");
+	}
 }
 
 
@@ -751,30 +1026,17 @@ void TcpServer::NotifyRejectUsers(std::shared_ptr<UserSession> user, std::shared
 
 void TcpServer::SendAllUsers(std::shared_ptr<myChatMessage::ChatMessage> msg)
 {
-	bool hasDisconnectedClient = false; // 연결이 끊긴 클라이언트 여부를 표시
+	// 메시지를 한 번만 직렬화하여 모든 수신자가 같은 프레임을 공유
+	auto frame = MessageConverter<myChatMessage::ChatMessage>::EncodeFrame(msg);
 
-	// 모든 사용자에게 메시지를 전송
-	for (auto user : m_Users)
+	// 모든 사용자에게 메시지를 전송 (연결이 끊긴 세션은 처리 루프에서 정리됨)
+	for (auto& [id, user] : m_Users)
 	{
 		if (user && user->IsConnected())
 		{
-			user->Send(msg);
-		}
-		else
-		{
-			hasDisconnectedClient = true;
+			user->SendFrame(frame);
 		}
 	}
-
-	// 연결이 끊긴 클라이언트를 벡터에서 제거
-	if (hasDisconnectedClient)
-	{
-		m_Users.erase(std::remove_if(m_Users.begin(), m_Users.end(),
-			[](const std::shared_ptr<UserSession>& u)
-			{
-				return !u || !u->IsConnected();
-			}), m_Users.end());
-	}
 }
 
 
@@ -788,14 +1050,12 @@ void TcpServer::SendWhisperMessage(std::shared_ptr<UserSession>& sender, const s
 	}
 
 	// 수신자가 존재하고 연결되어 있는 경우 메시지를 전송
-	for (auto& user : m_Users)
+	auto receiverSession = GetUserByUserId(receiver);
+	if (receiverSession && receiverSession->IsConnected())
 	{
-		if (user->GetUserEntity()->GetUserId() == receiver && user->IsConnected())
-		{
-			msg->set_receiver(receiver);
-			user->Send(msg);
-			return;
-		}
+		msg->set_receiver(receiver);
+		receiverSession->Send(msg);
+		return;
 	}
 
 	// 수신자를 찾지 못한 경우 에러 메시지 전송
@@ -808,15 +1068,18 @@ void TcpServer::SendPartyMessage(std::shared_ptr<Party>& party, std::shared_ptr<
 	// 파티가 유효한 경우 파티 멤버에게 메시지를 전송
 	if (party != nullptr)
 	{
-		auto partyMembers = party->GetMembers();
-		for (auto member : partyMembers)
-		{
-			auto session = GetUserById(member);
-			if (session != nullptr)
+		// 메시지를 한 번만 직렬화하여 모든 파티원이 같은 프레임을 공유
+		auto frame = MessageConverter<myChatMessage::ChatMessage>::EncodeFrame(msg);
+
+		// 파티가 보관한 세션 핸들로 바로 전송 (전체 사용자 목록을 조회하지 않음)
+		party->ForEachMember([&frame](const PartyMember& member)
 			{
-				session->Send(msg);
-			}
-		}
+				auto session = member.session.lock();
+				if (session != nullptr && session->IsConnected())
+				{
+					session->SendFrame(frame);
+				}
+			});
 	}
 }
 
@@ -826,7 +1089,7 @@ void TcpServer::SendErrorMessage(std::shared_ptr<UserSession>& user, const std::
 {
 	LOG_INFO("%s : %s", user->GetUserEntity()->GetUserId().c_str(), errorMessage.c_str());
 	// 클라이언트에게 전송할 에러 메시지 생성
-	auto errMsg = std::make_shared<myChatMessage::ChatMessage>();
+	auto errMsg = ObjectPool<myChatMessage::ChatMessage>::Acquire();
 	errMsg->set_messagetype(myChatMessage::ChatMessageType::ERROR_MESSAGE);
 	errMsg->set_content(errorMessage);
 
@@ -838,7 +1101,7 @@ void TcpServer::SendServerMessage(std::shared_ptr<UserSession>& user, const std:
 {
 	LOG_INFO("%s : %s", user->GetUserEntity()->GetUserId().c_str(), serverMessage.c_str());
 	// 서버 메시지 생성
-	auto serverMsg = std::make_shared<myChatMessage::ChatMessage>();
+	auto serverMsg = ObjectPool<myChatMessage::ChatMessage>::Acquire();
 	serverMsg->set_messagetype(myChatMessage::ChatMessageType::SERVER_MESSAGE);
 	serverMsg->set_content(serverMessage);
 
@@ -851,7 +1114,7 @@ void TcpServer::SendLoginMessage(std::shared_ptr<UserSession>& user)
 {
 	LOG_INFO("%s : %s", user->GetUserEntity()->GetUserId().c_str(), " : Login Success!!");
 	// 로그인 성공 메시지 생성
-	auto serverMsg = std::make_shared<myChatMessage::ChatMessage>();
+	auto serverMsg = ObjectPool<myChatMessage::ChatMessage>::Acquire();
 	serverMsg->set_messagetype(myChatMessage::ChatMessageType::LOGIN_MESSAGE);
 	serverMsg->set_content("Login Success!!");
 
@@ -886,15 +1149,22 @@ uint32_t TcpServer::StringToUint32(const std::string& str)
 }
 
 
+std::mutex& TcpServer::GetFriendPairMutex(uint32_t userId1, uint32_t userId2)
+{
+	// 요청 방향과 관계없이 같은 사용자 쌍은 같은 뮤텍스를 사용
+	uint64_t low = std::min(userId1, userId2);
+	uint64_t high = std::max(userId1, userId2);
+	return m_FriendPairMutexes[(low * 31 + high) % FRIEND_LOCK_COUNT];
+}
+
+
 std::shared_ptr<UserSession> TcpServer::GetUserById(uint32_t userId)
 {
 	// 사용자 ID에 해당하는 세션을 찾아 반환
-	for (auto user : m_Users)
+	auto it = m_Users.find(userId);
+	if (it != m_Users.end())
 	{
-		if (user->GetId() == userId)
-		{
-			return user;
-		}
+		return it->second;
 	}
 
 	return nullptr;
@@ -903,14 +1173,60 @@ std::shared_ptr<UserSession> TcpServer::GetUserById(uint32_t userId)
 
 std::shared_ptr<UserSession> TcpServer::GetUserByUserId(const std::string& userId)
 {
-	// 사용자 ID에 해당하는 세션을 찾아 반환
-	for (auto user : m_Users)
+	// 사용자 고유 ID에 해당하는 세션을 찾아 반환
+	auto it = m_UsersByUserId.find(userId);
+	if (it != m_UsersByUserId.end())
 	{
-		if (user->GetUserEntity()->GetUserId() == userId)
-		{
-			return user;
-		}
+		return it->second;
 	}
 
 	return nullptr;
-}
\ No newline at end of file
+}
+
+
+void TcpServer::AddUser(const std::shared_ptr<UserSession>& user)
+{
+	// 숫자 ID 와 고유 ID 양쪽 인덱스에 세션 등록
+	m_Users[user->GetId()] = user;
+	m_UsersByUserId[user->GetUserEntity()->GetUserId()] = user;
+	m_UserCache->AddOnlineUser(user->GetUserEntity());
+	m_FriendGraph->MarkOnline(user->GetId());
+}
+
+
+void TcpServer::RemoveUser(const std::shared_ptr<UserSession>& user)
+{
+	// 중복 로그인으로 이미 교체된 경우에는 새 세션을 지우지 않도록 같은 세션일 때만 제거
+	auto it = m_Users.find(user->GetId());
+	if (it != m_Users.end() && it->second == user)
+	{
+		m_Users.erase(it);
+	}
+
+	auto userIdIt = m_UsersByUserId.find(user->GetUserEntity()->GetUserId());
+	if (userIdIt != m_UsersByUserId.end() && userIdIt->second == user)
+	{
+		m_UsersByUserId.erase(userIdIt);
+	}
+
+	// 접속 중인 엔티티를 일반 캐시 항목으로 전환 (친구 요청 대상 조회 시 DB 조회 생략)
+	m_UserCache->RemoveOnlineUser(user->GetUserEntity());
+
+	// 다른 세션으로 다시 접속한 경우가 아니면 친구 관계도 메모리에서 내림
+	if (GetUserById(user->GetId()) == nullptr)
+	{
+		m_FriendGraph->Unload(user->GetId());
+	}
+
+	// 참여 중인 파티에서 제거 (파티장이면 위임, 마지막 멤버면 파티 해산)
+	if (user->GetPartyId() != 0)
+	{
+		auto newLeader = m_PartyManager->RemoveDisconnectedMember(user);
+		user->SetPartyId(0);
+
+		if (newLeader != nullptr)
+		{
+			SendServerMessage(newLeader, "The party leader has left. You are now the party leader.");
+		}
+	}
+}
@@ -3,37 +3,82 @@
 #include "Party/include/Party.h"
 #include "Party/include/PartyManager.h"
 #include "User/include/UserSession.h"
+#include "User/include/UserCache.h"
+#include "User/include/FriendGraph.h"
 #include "DB/include/RedisClient.hpp"
 #include "DB/include/MySQLManager.h"
 #include "Util/HSThreadPool.hpp"
+#include "Util/IoContextPool.hpp"
+#include "Util/SingleFlight.hpp"
 
 class TcpServer
 {
 private:
-    boost::asio::io_context& m_IoContext;        // Boost ASIO의 I/O 컨텍스트
+    // 이번 틱에 모인 로그인 검증 요청
+    struct VerifyRequest
+    {
+        std::shared_ptr<UserSession>    user;
+        std::string                     sessionId;
+    };
+
+    // 스레드 풀에서 끝난 로그인 검증 결과
+    struct VerifyResult
+    {
+        std::shared_ptr<UserSession>    user;
+        std::shared_ptr<UserEntity>     userEntity;     // 검증 실패 시 nullptr
+    };
+
+    boost::asio::io_context& m_IoContext;        // Boost ASIO의 I/O 컨텍스트 (Accept 전용)
     std::thread                                 m_ContextThread;    // 컨텍스트 실행을 위한 스레드
+    std::unique_ptr<IoContextPool>              m_IoContextPool;    // 유저 세션 송수신을 처리하는 I/O 컨텍스트 풀
 
     boost::asio::ip::tcp::acceptor              m_Acceptor;         // TCP 연결을 수락하는 객체
 
-    std::vector<std::shared_ptr<UserSession>>   m_Users;            // 연결된 사용자 세션들
+    std::unordered_map<uint32_t, std::shared_ptr<UserSession>>     m_Users;            // 연결된 사용자 세션들 (숫자 ID 기준)
+    std::unordered_map<std::string, std::shared_ptr<UserSession>>  m_UsersByUserId;    // 연결된 사용자 세션들 (고유 ID 기준)
     std::queue<std::shared_ptr<UserSession>>    m_NewUsers;         // 새로운 사용자 대기열
 
     std::mutex                                  m_UsersMutex;       // 사용자 세션 접근을 위한 뮤텍스
     std::mutex                                  m_NewUsersMutex;    // 새로운 사용자 대기열 접근을 위한 뮤텍스
 
+    std::vector<std::shared_ptr<UserSession>>   m_ReadyUsers;       // 처리할 메시지가 도착한 사용자 세션들
+    std::mutex                                  m_DispatchMutex;    // 처리 대기 세션 목록 접근을 위한 뮤텍스
+    std::condition_variable                     m_DispatchCV;       // 메시지 도착 시 처리 루프를 깨우는 조건 변수
+
+    std::vector<VerifyResult>                   m_VerifiedUsers;    // 검증이 끝나 로그인 처리를 기다리는 세션들 (m_DispatchMutex 로 보호)
+    uint32_t                                    m_VerifyingUserCount = 0;   // 스레드 풀에서 검증 중인 세션 수
+    std::vector<HSTask>                         m_DispatchJobs;     // 스레드 풀 작업이 처리 루프로 넘긴 후속 작업 (m_DispatchMutex 로 보호)
+
     std::unique_ptr<PartyManager>               m_PartyManager;     // 파티 관리자 객체
     std::unique_ptr<CRedisClient>               m_RedisClient;      // Redis 클라이언트 객체    
     std::unique_ptr<MySQLManager>               m_MySQLConnector;   // MySQL 관리자 객체
+    std::unique_ptr<UserCache>                  m_UserCache;        // 친구 요청 시 DB 조회를 줄이기 위한 사용자 캐시 (로그인 검증은 항상 DB 조회)
+
+    std::unique_ptr<FriendGraph>                m_FriendGraph;      // 접속 중인 사용자의 친구 관계 (친구 요청 확인을 메모리에서 처리)
+
+    SingleFlight<std::string, std::shared_ptr<UserEntity>>  m_UserLookupFlight;     // 같은 고유 ID 의 동시 사용자 조회를 하나로 합침
 
     uint32_t                                    m_MaxUser = 5;      // 최대 사용자 수
 
     HSThreadPool& m_ThreadPool;       // DB 작업을 처리하는 스레드 풀 객체
 
+    static constexpr size_t                     DISPATCH_BATCH_SIZE = 64;       // 한 번에 처리할 세션별 최대 메시지 수
+    static constexpr std::chrono::milliseconds  DISPATCH_IDLE_TIMEOUT{ 1000 };  // 이벤트가 없을 때 정리 작업 주기
+    static constexpr std::chrono::milliseconds  DB_JOB_TIMEOUT{ 5000 };         // 일반 DB 작업이 큐에서 기다릴 수 있는 최대 시간
+    static constexpr std::chrono::seconds       STATS_LOG_INTERVAL{ 60 };       // 서버 상태를 로그로 남기는 주기
+    static constexpr size_t                     USER_CACHE_CAPACITY = 10000;    // 캐시에 보관할 최대 DB 조회 결과 수 (접속 중인 사용자 제외)
+    static constexpr std::chrono::seconds       USER_CACHE_TTL{ 300 };          // DB 조회 결과를 재사용하는 시간
+    static constexpr size_t                     FRIEND_LOCK_COUNT = 64;         // 친구 작업 직렬화에 쓰는 사용자 쌍 뮤텍스 수
+
+    std::array<std::mutex, FRIEND_LOCK_COUNT>   m_FriendPairMutexes;    // 같은 사용자 쌍의 친구 요청/수락/거절을 한 번에 하나씩 실행
+
+    std::chrono::steady_clock::time_point       m_LastStatsLogTime; // 마지막으로 서버 상태를 남긴 시각
+
 
 public:
     TcpServer(boost::asio::io_context& io_context, int port, std::unique_ptr<CRedisClient> redisClient, std::unique_ptr<MySQLManager> mysqlManager, HSThreadPool& threadPool);
     ~TcpServer();
-    bool Start(uint32_t maxUser);
+    bool Start(uint32_t maxUser, size_t ioThreadCount = 0);
     void Update();
 
     std::shared_ptr<UserSession> GetUserById(uint32_t userId);
@@ -41,12 +86,20 @@ public:
 
 private:
 
-    void EnqueueJob(std::function<void()>&& task);
+    void EnqueueJob(HSTask&& task);
+    void PostToDispatch(HSTask&& task);
+    template<typename Work, typename OnSuccess, typename OnError>
+    void EnqueueJobThen(Work&& work, OnSuccess&& onSuccess, OnError&& onError);
 
     void WaitForClientConnection();
     void UpdateUsers();
-    bool VerifyUser(std::shared_ptr<UserSession>& user, const std::string& sessionId);
+    void NotifyDispatch(std::shared_ptr<UserSession> user);
+    void DispatchUserMessages(std::shared_ptr<UserSession>& user);
+    void AdmitVerifiedUsers(std::vector<VerifyResult>& verifiedUsers);
+    std::vector<VerifyResult> VerifyUsers(const std::vector<VerifyRequest>& requests);
 
+    void AddUser(const std::shared_ptr<UserSession>& user);
+    void RemoveUser(const std::shared_ptr<UserSession>& user);
     void RemoveUserSessions();
     void RemoveNewUserSessions();
 
@@ -73,17 +126,56 @@ private:
     void HandleFriendReject(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg);
 
 
-    std::future<void> ValidateRequest(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg);
-    std::future<std::shared_ptr<UserEntity>> CheckUserExistence(const std::string& userId);
-    std::future<void> CheckFriendRequestStatus(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser);
-    std::future<void> AddFriendRequest(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser);
+    void ValidateRequest(std::shared_ptr<UserSession> user, std::shared_ptr<myChatMessage::ChatMessage> msg);
+    std::shared_ptr<UserEntity> CheckUserExistence(const std::string& userId);
+    void CheckFriendRequestStatus(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser);
+    void AddFriendRequest(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser);
     void NotifyUsers(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> receiveUser);
 
-    std::future<void> ProcessFriendAccept(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender);
+    void ProcessFriendAccept(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender);
     void NotifyAcceptUsers(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender);
 
-    std::future<void> ProcessFriendReject(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender);
+    void ProcessFriendReject(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender);
     void NotifyRejectUsers(std::shared_ptr<UserSession> user, std::shared_ptr<UserEntity> sender);
 
+    std::mutex& GetFriendPairMutex(uint32_t userId1, uint32_t userId2);
+
+    void LogServerStats();
+
     uint32_t StringToUint32(const std::string& str);
-};
\ No newline at end of file
+};
+
+// 스레드 풀에서 work 를 실행하고, 결과는 처리 루프에서 onSuccess 로, 예외는 onError 로 전달하는 함수
+// (처리 루프는 DB 작업을 기다리지 않으며, 후속 처리는 사용자 목록에 안전하게 접근할 수 있음)
+template<typename Work, typename OnSuccess, typename OnError>
+void TcpServer::EnqueueJobThen(Work&& work, OnSuccess&& onSuccess, OnError&& onError)
+{
+    // 큐에서 기한을 넘기면 실행하지 않고 바로 실패를 알리므로 onError 는 두 경로가 함께 사용
+    auto sharedOnError = std::make_shared<std::decay_t<OnError>>(std::forward<OnError>(onError));
+
+    m_ThreadPool.PostJob(JobOptions{ JobPriority::Normal, DB_JOB_TIMEOUT },
+        [this, work = std::forward<Work>(work), onSuccess = std::forward<OnSuccess>(onSuccess), onError = sharedOnError]() mutable
+        {
+            using result_type = std::invoke_result_t<Work&>;
+            try
+            {
+                if constexpr (std::is_void_v<result_type>)
+                {
+                    work();
+                    PostToDispatch(std::move(onSuccess));
+                }
+                else
+                {
+                    PostToDispatch([onSuccess = std::move(onSuccess), result = work()]() mutable { onSuccess(std::move(result)); });
+                }
+            }
+            catch (const std::exception& e)
+            {
+                PostToDispatch([onError = std::move(onError), error = std::string(e.what())]() mutable { (*onError)(error); });
+            }
+        },
+        [this, onError = sharedOnError]() mutable
+        {
+            PostToDispatch([onError = std::move(onError)]() mutable { (*onError)("Server is busy. Please try again later."); });
+        });
+}
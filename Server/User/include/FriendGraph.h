@@ -0,0 +1,108 @@
+#pragma once
+#include "Common.h"
+#include "DB/include/MySQLManager.h"
+#include "Util/SingleFlight.hpp"
+
+// 접속 중인 사용자의 친구 관계와 친구 요청을 메모리에 올려 두는 그래프
+// 사용자별 관계는 처음 조회할 때 DB 에서 읽어오고(정렬된 ID 배열), 이후 변경은 DB 반영 후 함께 갱신합니다.
+// 접속 중(MarkOnline ~ Unload)인 사용자의 관계만 보관하고, 그 외 사용자는 DB 에서 읽은 결과로 응답만 합니다.
+class FriendGraph
+{
+public:
+    struct Stats
+    {
+        uint64_t loadCount;         // DB 에서 관계를 읽어온 수
+        uint64_t hitCount;          // 메모리에서 바로 응답한 수
+        size_t loadedUserCount;     // 관계가 올라와 있는 사용자 수
+    };
+
+    explicit FriendGraph(MySQLManager& mysqlManager);
+
+    // userId 기준 관계 조회 (userId 의 관계가 없으면 DB 에서 읽어옴)
+    bool HasSentRequest(uint32_t userId, uint32_t otherId);         // userId -> otherId 요청 (대기 또는 수락)
+    bool HasReceivedRequest(uint32_t userId, uint32_t otherId);     // otherId -> userId 요청 (대기 또는 수락)
+    bool IsFriend(uint32_t userId, uint32_t otherId);
+    std::vector<uint32_t> GetFriendIds(uint32_t userId);
+
+    // DB 반영이 끝난 변경을 메모리에 올라온 사용자에게만 반영
+    void AddFriendRequest(uint32_t senderId, uint32_t receiverId);
+    void UpdateFriendRequest(uint32_t senderId, uint32_t receiverId, const std::string& status);
+    void RemoveFriendRequest(uint32_t senderId, uint32_t receiverId);
+    void AddFriendship(uint32_t userId1, uint32_t userId2);
+
+    // 접속 시 호출
+    void MarkOnline(uint32_t userId);
+    // 접속 종료 시 호출 (읽어오는 중인 관계도 보관하지 않음)
+    void Unload(uint32_t userId);
+
+    Stats GetStats() const;
+
+private:
+    // 사용자 한 명의 관계 (모두 오름차순 정렬)
+    struct Links
+    {
+        std::vector<uint32_t> friends;
+        std::vector<uint32_t> sentRequests;
+        std::vector<uint32_t> receivedRequests;
+    };
+
+    // DB 에서 읽는 중인 사용자의 상태
+    struct LoadState
+    {
+        bool changed = false;       // 읽는 동안 관계가 바뀜 (다시 읽어야 함)
+        bool discarded = false;     // 읽는 동안 접속 종료됨 (읽은 결과를 보관하지 않음)
+    };
+
+    static bool Contains(const std::vector<uint32_t>& ids, uint32_t id);
+    static void Insert(std::vector<uint32_t>& ids, uint32_t id);
+    static void Erase(std::vector<uint32_t>& ids, uint32_t id);
+
+    Links LoadLinks(uint32_t userId);
+    std::shared_ptr<const Links> Load(uint32_t userId);
+
+    // userId 의 관계를 읽어 func 에 전달 (메모리에 없으면 DB 에서 읽은 결과 사용)
+    template<typename Func>
+    auto ReadLinks(uint32_t userId, Func&& func)
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            auto it = m_Links.find(userId);
+            if (it != m_Links.end())
+            {
+                ++m_HitCount;
+                return func(it->second);
+            }
+        }
+
+        auto links = Load(userId);
+        return func(*links);
+    }
+
+    // 변경을 반영 (잠금 상태에서 호출, 읽어오는 중인 사용자는 다시 읽도록 표시)
+    template<typename Func>
+    void UpdateLinksLocked(uint32_t userId, Func&& func)
+    {
+        auto it = m_Links.find(userId);
+        if (it != m_Links.end())
+        {
+            func(it->second);
+        }
+
+        auto loadingIt = m_Loading.find(userId);
+        if (loadingIt != m_Loading.end())
+        {
+            loadingIt->second.changed = true;
+        }
+    }
+
+    MySQLManager&                               m_MySQLManager;
+
+    mutable std::mutex                          m_Mutex;
+    std::unordered_map<uint32_t, Links>         m_Links;        // 사용자별 관계 (접속 중인 사용자만)
+    std::unordered_set<uint32_t>                m_OnlineUsers;  // 접속 중인 사용자
+    std::unordered_map<uint32_t, LoadState>     m_Loading;      // DB 에서 읽는 중인 사용자
+    SingleFlight<uint32_t, std::shared_ptr<const Links>>    m_LoadFlight;   // 같은 사용자의 동시 로드를 하나로 합침
+
+    std::atomic<uint64_t>                       m_LoadCount = 0;
+    std::atomic<uint64_t>                       m_HitCount = 0;
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include "Common.h"
+#include "UserEntity.hpp"
+
+// MySQL 앞단의 사용자 엔티티 캐시 (고유 ID 로 조회, 항목은 숫자 ID 기준으로 보관)
+// 접속 중인 세션의 엔티티를 먼저 찾고, 없으면 최근 DB 조회 결과를 TTL 동안 재사용합니다.
+// 반환된 엔티티는 여러 스레드가 공유하므로 수정하지 않아야 합니다.
+// 다른 프로세스(ApiServer)의 사용자 수정/삭제는 알 수 없으므로 조회 결과는 최대 TTL 만큼 오래된 값일 수 있습니다.
+// 최신 값이 필요한 로그인 검증은 캐시를 거치지 않고 DB 에서 읽은 뒤 Put 으로 갱신합니다.
+class UserCache
+{
+public:
+    struct Stats
+    {
+        uint64_t onlineHitCount;    // 접속 중인 세션의 엔티티로 응답한 수
+        uint64_t hitCount;          // 캐시된 DB 조회 결과로 응답한 수
+        uint64_t missCount;         // DB 조회가 필요했던 수
+        uint64_t evictionCount;     // 용량 초과나 만료로 제거된 수
+        size_t onlineCount;         // 접속 중인 사용자 수
+        size_t cachedCount;         // 캐시된 DB 조회 결과 수
+    };
+
+    UserCache(size_t capacity, std::chrono::seconds ttl);
+
+    std::shared_ptr<UserEntity> FindByUserId(const std::string& userId);
+
+    // DB 에서 읽어온 엔티티를 캐시에 저장
+    void Put(const std::shared_ptr<UserEntity>& user);
+
+    // 로그인/로그아웃 시 호출 (접속 중인 엔티티는 용량과 TTL 에 관계없이 유지)
+    void AddOnlineUser(const std::shared_ptr<UserEntity>& user);
+    void RemoveOnlineUser(const std::shared_ptr<UserEntity>& user);
+
+    Stats GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        std::shared_ptr<UserEntity>     user;
+        Clock::time_point               expireTime;
+        std::list<uint32_t>::iterator   lruIt;      // m_Lru 에서의 위치
+    };
+
+    std::shared_ptr<UserEntity> FindLocked(uint32_t id);
+    void EraseLocked(std::unordered_map<uint32_t, Entry>::iterator it);
+
+    size_t                                                      m_Capacity;
+    std::chrono::seconds                                        m_Ttl;
+
+    mutable std::mutex                                          m_Mutex;
+    std::unordered_map<uint32_t, std::shared_ptr<UserEntity>>  m_OnlineUsers;      // 접속 중인 세션의 엔티티
+    std::unordered_map<std::string, uint32_t>                   m_OnlineIds;        // 고유 ID -> 숫자 ID (접속 중)
+    std::unordered_map<uint32_t, Entry>                         m_Entries;          // DB 조회 결과
+    std::unordered_map<std::string, uint32_t>                   m_EntryIds;         // 고유 ID -> 숫자 ID (DB 조회 결과)
+    std::list<uint32_t>                                         m_Lru;              // 최근에 사용한 순서 (앞쪽이 최근)
+
+    std::atomic<uint64_t>                                       m_OnlineHitCount = 0;
+    std::atomic<uint64_t>                                       m_HitCount = 0;
+    std::atomic<uint64_t>                                       m_MissCount = 0;
+    std::atomic<uint64_t>                                       m_EvictionCount = 0;
+};
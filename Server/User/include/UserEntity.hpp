@@ -1,8 +1,13 @@
 #pragma once
 #include "Common.h"
 
+template<typename T>
+struct RowMapping;
+
 class UserEntity
 {
+    friend struct RowMapping<UserEntity>;   // DB 결과 행을 필드에 바로 읽어오기 위해 허용
+
 private:
     uint32_t        m_Id;       // 사용자 ID
     std::string     m_UserId;   // 사용자 고유 ID
@@ -15,10 +20,10 @@ public:
 
     // Getter methods
     uint32_t GetId() const { return m_Id; } // ID 반환
-    std::string GetUserId() const { return m_UserId; } // 고유 ID 반환
-    std::string GetPassword() const { return m_Password; } // 비밀번호 반환
-    std::string GetUsername() const { return m_Username; } // 이름 반환
-    std::string GetEmail() const { return m_Email; } // 이메일 반환
+    const std::string& GetUserId() const { return m_UserId; } // 고유 ID 반환
+    const std::string& GetPassword() const { return m_Password; } // 비밀번호 반환
+    const std::string& GetUsername() const { return m_Username; } // 이름 반환
+    const std::string& GetEmail() const { return m_Email; } // 이메일 반환
     char GetIsAlive() const { return m_IsAlive; } // 활성 상태 반환
 
     // Setter methods
@@ -2,6 +2,7 @@
 #include "Common.h"
 #include "Message/MyMessage.pb.h"
 #include "Util/PacketConverter.hpp"
+#include "Util/SpscRingBuffer.hpp"
 #include "DB/include/MySQLManager.h"
 #include "UserEntity.hpp"
 
@@ -15,20 +16,32 @@ private:
 	std::shared_ptr<UserEntity>													m_UserEntity;
 	uint32_t																	m_PartyId = 0;
 
-	bool																		m_IsActive = false;
+	std::atomic<bool>															m_IsActive = false;
 	bool																		m_Verified = false;
 
-	std::vector<uint8_t>														m_Writebuf;
 	std::vector<uint8_t>														m_Readbuf;
+	size_t																		m_ReadBegin = 0;
+	size_t																		m_ReadEnd = 0;
 
-	std::shared_ptr<std::queue<std::shared_ptr<myChatMessage::ChatMessage>>>	m_MessageQueue1;
-	std::shared_ptr<std::queue<std::shared_ptr<myChatMessage::ChatMessage>>>	m_MessageQueue2;
+	std::deque<EncodedFrame>													m_WriteQueue;
+	std::vector<EncodedFrame>													m_WritingFrames;
+	std::vector<boost::asio::const_buffer>										m_WriteBuffers;
+	bool																		m_IsWriting = false;
+	bool																		m_CloseAfterWrite = false;
 
-	std::shared_ptr<std::queue<std::shared_ptr<myChatMessage::ChatMessage>>>	m_InputQueue;
-	std::shared_ptr<std::queue<std::shared_ptr<myChatMessage::ChatMessage>>>	m_OutputQueue;
-	std::mutex																	m_QueueMutex;
+	SpscRingBuffer<std::shared_ptr<myChatMessage::ChatMessage>>					m_InboundQueue;
+	static inline std::atomic<uint64_t>											s_InboundOverflowCount = 0;
 
 	boost::asio::steady_timer													m_PingTimer;
+	boost::asio::steady_timer													m_CloseTimer;
+
+	std::function<void(std::shared_ptr<UserSession>)>							m_DispatchHandler;
+	std::atomic<bool>															m_DispatchRequested = false;
+
+	static constexpr size_t														MAX_GATHER_FRAMES = 64;
+	static constexpr size_t														READ_BUFFER_SIZE = 8192;
+	static constexpr size_t														INBOUND_QUEUE_SIZE = 1024;
+	static constexpr std::chrono::seconds										CLOSE_GRACE_PERIOD{ 3 };	// max time Close() waits for pending frames
 
 
 public:
@@ -48,10 +61,16 @@ public:
 	void SetPartyId(uint32_t partyId);
 	void SetVerified(bool isVerified);
 	void SetUserEntity(std::shared_ptr<UserEntity> userEntity);
+	void SetDispatchHandler(std::function<void(std::shared_ptr<UserSession>)> handler);
 
 
 	std::shared_ptr<myChatMessage::ChatMessage> GetMessageInUserQueue();
+	size_t GetInboundQueueSize() const;
+	static uint64_t GetInboundOverflowCount();
+	void RequestDispatch();
+	void ResetDispatchRequest();
 	void Send(std::shared_ptr<myChatMessage::ChatMessage> msg);
+	void SendFrame(EncodedFrame frame);
 
 	boost::asio::ip::tcp::socket& GetSocket();
 
@@ -60,11 +79,11 @@ private:
 	void StartPingTimer();
 	std::string GetCurrentTimeMilliseconds();
 
-	bool SwapQueues();
-
-	void AsyncWrite(std::shared_ptr<myChatMessage::ChatMessage> msg);
-	void ReadHeader();
-	void ReadBody(size_t bodySize);
+	void AsyncWrite();
+	void AsyncRead();
+	bool ProcessReadBuffer();
+	void CompactReadBuffer();
+	void CloseSocket();
 
 	void HandleError(const std::string& errorMessage);
 };
@@ -0,0 +1,192 @@
+#include "User/include/FriendGraph.h"
+
+FriendGraph::FriendGraph(MySQLManager& mysqlManager)
+    : m_MySQLManager(mysqlManager)
+{
+}
+
+bool FriendGraph::HasSentRequest(uint32_t userId, uint32_t otherId)
+{
+    return ReadLinks(userId, [otherId](const Links& links) { return Contains(links.sentRequests, otherId); });
+}
+
+bool FriendGraph::HasReceivedRequest(uint32_t userId, uint32_t otherId)
+{
+    return ReadLinks(userId, [otherId](const Links& links) { return Contains(links.receivedRequests, otherId); });
+}
+
+bool FriendGraph::IsFriend(uint32_t userId, uint32_t otherId)
+{
+    return ReadLinks(userId, [otherId](const Links& links) { return Contains(links.friends, otherId); });
+}
+
+std::vector<uint32_t> FriendGraph::GetFriendIds(uint32_t userId)
+{
+    return ReadLinks(userId, [](const Links& links) { return links.friends; });
+}
+
+void FriendGraph::AddFriendRequest(uint32_t senderId, uint32_t receiverId)
+{
+    std::scoped_lock lock(m_Mutex);
+    UpdateLinksLocked(senderId, [receiverId](Links& links) { Insert(links.sentRequests, receiverId); });
+    UpdateLinksLocked(receiverId, [senderId](Links& links) { Insert(links.receivedRequests, senderId); });
+}
+
+void FriendGraph::UpdateFriendRequest(uint32_t senderId, uint32_t receiverId, const std::string& status)
+{
+    // 대기(P)와 수락(A) 상태만 요청이 있는 것으로 봄 (DB 조회 조건과 동일)
+    if (status == "P" || status == "A")
+    {
+        AddFriendRequest(senderId, receiverId);
+    }
+    else
+    {
+        RemoveFriendRequest(senderId, receiverId);
+    }
+}
+
+void FriendGraph::RemoveFriendRequest(uint32_t senderId, uint32_t receiverId)
+{
+    std::scoped_lock lock(m_Mutex);
+    UpdateLinksLocked(senderId, [receiverId](Links& links) { Erase(links.sentRequests, receiverId); });
+    UpdateLinksLocked(receiverId, [senderId](Links& links) { Erase(links.receivedRequests, senderId); });
+}
+
+void FriendGraph::AddFriendship(uint32_t userId1, uint32_t userId2)
+{
+    std::scoped_lock lock(m_Mutex);
+    UpdateLinksLocked(userId1, [userId2](Links& links) { Insert(links.friends, userId2); });
+    UpdateLinksLocked(userId2, [userId1](Links& links) { Insert(links.friends, userId1); });
+}
+
+void FriendGraph::MarkOnline(uint32_t userId)
+{
+    std::scoped_lock lock(m_Mutex);
+    m_OnlineUsers.insert(userId);
+}
+
+void FriendGraph::Unload(uint32_t userId)
+{
+    std::scoped_lock lock(m_Mutex);
+    m_OnlineUsers.erase(userId);
+    m_Links.erase(userId);
+
+    auto loadingIt = m_Loading.find(userId);
+    if (loadingIt != m_Loading.end())
+    {
+        loadingIt->second.discarded = true;
+    }
+}
+
+FriendGraph::Stats FriendGraph::GetStats() const
+{
+    std::scoped_lock lock(m_Mutex);
+    return { m_LoadCount.load(), m_HitCount.load(), m_Links.size() };
+}
+
+bool FriendGraph::Contains(const std::vector<uint32_t>& ids, uint32_t id)
+{
+    return std::binary_search(ids.begin(), ids.end(), id);
+}
+
+void FriendGraph::Insert(std::vector<uint32_t>& ids, uint32_t id)
+{
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id)
+    {
+        ids.insert(it, id);
+    }
+}
+
+void FriendGraph::Erase(std::vector<uint32_t>& ids, uint32_t id)
+{
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it != ids.end() && *it == id)
+    {
+        ids.erase(it);
+    }
+}
+
+FriendGraph::Links FriendGraph::LoadLinks(uint32_t userId)
+{
+    Links links;
+    std::string id = std::to_string(userId);
+
+    for (auto& row : m_MySQLManager.GetFriendships(id))
+    {
+        links.friends.push_back(row.userId1 == userId ? row.userId2 : row.userId1);
+    }
+
+    for (auto& row : m_MySQLManager.GetFriendRequests(id))
+    {
+        if (row.senderId == userId)
+        {
+            links.sentRequests.push_back(row.receiverId);
+        }
+        if (row.receiverId == userId)
+        {
+            links.receivedRequests.push_back(row.senderId);
+        }
+    }
+
+    for (auto* ids : { &links.friends, &links.sentRequests, &links.receivedRequests })
+    {
+        std::sort(ids->begin(), ids->end());
+        ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+        ids->shrink_to_fit();
+    }
+
+    return links;
+}
+
+std::shared_ptr<const FriendGraph::Links> FriendGraph::Load(uint32_t userId)
+{
+    // 같은 사용자를 동시에 읽는 경우 한 번만 DB 를 조회
+    return m_LoadFlight.Do(userId, [this, userId]()
+        {
+            while (true)
+            {
+                {
+                    std::scoped_lock lock(m_Mutex);
+                    auto it = m_Links.find(userId);
+                    if (it != m_Links.end())
+                    {
+                        return std::make_shared<const Links>(it->second);
+                    }
+                    m_Loading[userId] = LoadState{};
+                }
+
+                auto links = std::make_shared<Links>();
+                try
+                {
+                    *links = LoadLinks(userId);
+                }
+                catch (const std::exception&)
+                {
+                    std::scoped_lock lock(m_Mutex);
+                    m_Loading.erase(userId);
+                    throw;
+                }
+
+                ++m_LoadCount;
+
+                std::scoped_lock lock(m_Mutex);
+                auto loadingIt = m_Loading.find(userId);
+                LoadState state = loadingIt->second;
+                m_Loading.erase(loadingIt);
+
+                // 읽는 동안 이 사용자의 관계가 바뀌었으면 DB 에서 다시 읽음
+                if (state.changed)
+                {
+                    continue;
+                }
+
+                // 접속 중인 사용자만 보관 (읽는 동안 접속 종료된 경우에는 결과만 반환)
+                if (!state.discarded && m_OnlineUsers.count(userId))
+                {
+                    m_Links.emplace(userId, *links);
+                }
+                return std::shared_ptr<const Links>(std::move(links));
+            }
+        });
+}
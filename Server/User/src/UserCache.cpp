@@ -0,0 +1,153 @@
+#include "User/include/UserCache.h"
+
+UserCache::UserCache(size_t capacity, std::chrono::seconds ttl)
+    : m_Capacity(std::max<size_t>(1, capacity))
+    , m_Ttl(ttl)
+{
+}
+
+std::shared_ptr<UserEntity> UserCache::FindByUserId(const std::string& userId)
+{
+    std::scoped_lock lock(m_Mutex);
+
+    auto onlineIt = m_OnlineIds.find(userId);
+    if (onlineIt != m_OnlineIds.end())
+    {
+        return FindLocked(onlineIt->second);
+    }
+
+    auto entryIt = m_EntryIds.find(userId);
+    if (entryIt != m_EntryIds.end())
+    {
+        return FindLocked(entryIt->second);
+    }
+
+    ++m_MissCount;
+    return nullptr;
+}
+
+std::shared_ptr<UserEntity> UserCache::FindLocked(uint32_t id)
+{
+    // 접속 중인 세션의 엔티티를 먼저 사용
+    auto onlineIt = m_OnlineUsers.find(id);
+    if (onlineIt != m_OnlineUsers.end())
+    {
+        ++m_OnlineHitCount;
+        return onlineIt->second;
+    }
+
+    auto it = m_Entries.find(id);
+    if (it == m_Entries.end())
+    {
+        ++m_MissCount;
+        return nullptr;
+    }
+
+    // 만료된 항목은 제거하고 DB 에서 다시 읽도록 함
+    if (Clock::now() >= it->second.expireTime)
+    {
+        EraseLocked(it);
+        ++m_EvictionCount;
+        ++m_MissCount;
+        return nullptr;
+    }
+
+    m_Lru.splice(m_Lru.begin(), m_Lru, it->second.lruIt);
+    ++m_HitCount;
+    return it->second.user;
+}
+
+void UserCache::Put(const std::shared_ptr<UserEntity>& user)
+{
+    if (user == nullptr)
+    {
+        return;
+    }
+
+    std::scoped_lock lock(m_Mutex);
+
+    // 접속 중인 사용자는 세션의 엔티티가 우선하므로 저장하지 않음
+    if (m_OnlineUsers.count(user->GetId()))
+    {
+        return;
+    }
+
+    auto it = m_Entries.find(user->GetId());
+    if (it != m_Entries.end())
+    {
+        EraseLocked(it);
+    }
+
+    m_Lru.push_front(user->GetId());
+    m_Entries.emplace(user->GetId(), Entry{ user, Clock::now() + m_Ttl, m_Lru.begin() });
+    m_EntryIds[user->GetUserId()] = user->GetId();
+
+    // 용량을 넘으면 가장 오래 사용하지 않은 항목부터 제거
+    while (m_Entries.size() > m_Capacity)
+    {
+        EraseLocked(m_Entries.find(m_Lru.back()));
+        ++m_EvictionCount;
+    }
+}
+
+void UserCache::AddOnlineUser(const std::shared_ptr<UserEntity>& user)
+{
+    if (user == nullptr)
+    {
+        return;
+    }
+
+    std::scoped_lock lock(m_Mutex);
+
+    auto it = m_Entries.find(user->GetId());
+    if (it != m_Entries.end())
+    {
+        EraseLocked(it);
+    }
+
+    m_OnlineUsers[user->GetId()] = user;
+    m_OnlineIds[user->GetUserId()] = user->GetId();
+}
+
+void UserCache::RemoveOnlineUser(const std::shared_ptr<UserEntity>& user)
+{
+    if (user == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock lock(m_Mutex);
+
+        // 중복 로그인으로 이미 교체된 경우에는 새 세션의 엔티티를 지우지 않음
+        auto it = m_OnlineUsers.find(user->GetId());
+        if (it == m_OnlineUsers.end() || it->second != user)
+        {
+            return;
+        }
+
+        m_OnlineUsers.erase(it);
+        m_OnlineIds.erase(user->GetUserId());
+    }
+
+    // 접속 종료 후에도 친구 요청 대상 조회 등에 쓰도록 일반 항목으로 남겨 둠
+    Put(user);
+}
+
+void UserCache::EraseLocked(std::unordered_map<uint32_t, Entry>::iterator it)
+{
+    auto idIt = m_EntryIds.find(it->second.user->GetUserId());
+    if (idIt != m_EntryIds.end() && idIt->second == it->first)
+    {
+        m_EntryIds.erase(idIt);
+    }
+
+    m_Lru.erase(it->second.lruIt);
+    m_Entries.erase(it);
+}
+
+UserCache::Stats UserCache::GetStats() const
+{
+    std::scoped_lock lock(m_Mutex);
+    return { m_OnlineHitCount.load(), m_HitCount.load(), m_MissCount.load(), m_EvictionCount.load(), m_OnlineUsers.size(), m_Entries.size() };
+}
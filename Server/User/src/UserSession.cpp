@@ -5,14 +5,12 @@ UserSession::UserSession(boost::asio::io_context& io_context)
 	: m_IoContext(io_context)
 	, m_Socket(io_context)
 	, m_PingTimer(io_context, std::chrono::seconds(5))
+	, m_CloseTimer(io_context)
 	, m_IsActive(true)
 	, m_UserEntity(std::make_shared<UserEntity>())
+	, m_InboundQueue(INBOUND_QUEUE_SIZE)
 {
-	m_MessageQueue1 = std::make_shared<std::queue<std::shared_ptr<myChatMessage::ChatMessage>>>();
-	m_MessageQueue2 = std::make_shared<std::queue<std::shared_ptr<myChatMessage::ChatMessage>>>();
-
-	m_InputQueue = m_MessageQueue1;
-	m_OutputQueue = m_MessageQueue2;
+	m_Readbuf.resize(READ_BUFFER_SIZE);
 }
 
 UserSession::~UserSession()
@@ -29,12 +27,59 @@ UserSession::~UserSession()
 void UserSession::Start()
 {
 	m_IsActive = true;
-	ReadHeader();
+	AsyncRead();
 }
 
 void UserSession::Close()
 {
-	m_IsActive = false;
+	// 이미 종료된 세션이면 무시
+	if (!m_IsActive.exchange(false))
+	{
+		return;
+	}
+
+	// 소멸자에서 호출된 경우에는 소멸자가 소켓을 정리
+	auto self = weak_from_this().lock();
+	if (!self)
+	{
+		return;
+	}
+
+	// 소켓은 세션의 I/O 스레드에서 닫아 대기 중인 읽기를 중단
+	boost::asio::post(m_IoContext,
+		[this, self]()
+		{
+			// 전송 중인 프레임(중복 로그인 안내 등)이 있으면 전송 완료 후 닫음
+			if (m_IsWriting)
+			{
+				m_CloseAfterWrite = true;
+
+				// 더 이상 받지 않고, 상대가 읽지 않아 전송이 끝나지 않으면 유예 시간 후 강제로 닫음
+				boost::system::error_code ec;
+				m_Socket.shutdown(boost::asio::ip::tcp::socket::shutdown_receive, ec);
+				m_CloseTimer.expires_after(CLOSE_GRACE_PERIOD);
+				m_CloseTimer.async_wait([this, self](const boost::system::error_code& err)
+					{
+						if (!err)
+						{
+							LOG_INFO("[SERVER] User { %d } did not drain pending frames. Closing socket.", m_Id);
+							CloseSocket();
+						}
+					});
+				return;
+			}
+
+			CloseSocket();
+		});
+}
+
+void UserSession::CloseSocket()
+{
+	boost::system::error_code ec;
+	m_Socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+	m_Socket.close(ec);
+	m_PingTimer.cancel();
+	m_CloseTimer.cancel();
 }
 
 bool UserSession::IsConnected()
@@ -82,38 +127,55 @@ void UserSession::SetUserEntity(std::shared_ptr<UserEntity> userEntity)
 	m_UserEntity = std::move(userEntity);
 }
 
-std::shared_ptr<myChatMessage::ChatMessage> UserSession::GetMessageInUserQueue()
+void UserSession::SetDispatchHandler(std::function<void(std::shared_ptr<UserSession>)> handler)
 {
-	if (m_OutputQueue->empty() && !SwapQueues()) // 출력 큐가 비어 있고, 입력 큐와 교체할 수 없는 경우
-	{
-		return nullptr; // 메시지 없음
-	}
+	m_DispatchHandler = std::move(handler);
+}
 
-	auto msg = m_OutputQueue->front(); // 출력 큐의 맨 앞 메시지 가져오기
-	if (!msg)
+std::shared_ptr<myChatMessage::ChatMessage> UserSession::GetMessageInUserQueue()
+{
+	// 처리 루프(소비자)만 호출하므로 락 없이 수신 큐에서 꺼냄
+	std::shared_ptr<myChatMessage::ChatMessage> msg;
+	if (!m_InboundQueue.TryPop(msg))
 	{
 		return nullptr; // 메시지 없음
 	}
 
-	m_OutputQueue->pop(); // 큐에서 메시지 제거
 	return msg; // 메시지 반환
 }
 
-boost::asio::ip::tcp::socket& UserSession::GetSocket()
+size_t UserSession::GetInboundQueueSize() const
 {
-	return m_Socket; // 소켓 객체 반환
+	return m_InboundQueue.Size(); // 처리되지 않은 수신 메시지 수
 }
 
-bool UserSession::SwapQueues()
+uint64_t UserSession::GetInboundOverflowCount()
 {
-	std::lock_guard<std::mutex> lock(m_QueueMutex); // 큐 뮤텍스로 잠금
-	if (m_OutputQueue->empty() && !m_InputQueue->empty()) // 출력 큐가 비어 있고, 입력 큐가 비어 있지 않은 경우
+	return s_InboundOverflowCount.load(); // 수신 큐가 가득 차서 종료된 세션 수 (서버 전체)
+}
+
+void UserSession::RequestDispatch()
+{
+	// 이미 처리 요청이 걸려 있으면 중복으로 알리지 않음
+	if (m_DispatchRequested.exchange(true))
+	{
+		return;
+	}
+
+	if (m_DispatchHandler)
 	{
-		std::swap(m_InputQueue, m_OutputQueue); // 입력 큐와 출력 큐 교체
-		return true; // 교체 성공
+		m_DispatchHandler(shared_from_this()); // 서버 처리 루프에 이벤트 알림
 	}
+}
+
+void UserSession::ResetDispatchRequest()
+{
+	m_DispatchRequested = false; // 이후 도착하는 메시지는 다시 알림을 보냄
+}
 
-	return false; // 교체 실패
+boost::asio::ip::tcp::socket& UserSession::GetSocket()
+{
+	return m_Socket; // 소켓 객체 반환
 }
 
 
@@ -140,7 +202,7 @@ void UserSession::StartPingTimer()
 
 void UserSession::SendPing()
 {
-    auto pingMsg = std::make_shared<myChatMessage::ChatMessage>(); // ping 메시지 생성
+    auto pingMsg = ObjectPool<myChatMessage::ChatMessage>::Acquire(); // ping 메시지 생성
     pingMsg->set_messagetype(myChatMessage::ChatMessageType::SERVER_PING); // 메시지 타입 설정
     pingMsg->set_content(GetCurrentTimeMilliseconds()); // 현재 시간 밀리초로 설정
     LOG_DEBUG("Sending ping with content: %s", pingMsg->content().c_str());
@@ -155,27 +217,71 @@ std::string UserSession::GetCurrentTimeMilliseconds()
 }
 
 void UserSession::Send(std::shared_ptr<myChatMessage::ChatMessage> msg)
+{
+    SendFrame(MessageConverter<myChatMessage::ChatMessage>::EncodeFrame(msg)); // 메시지 직렬화 후 전송
+}
+
+void UserSession::SendFrame(EncodedFrame frame)
 {
     boost::asio::post(m_IoContext,
-        [this, msg]()
+        [this, self = shared_from_this(), frame = std::move(frame)]() mutable
         {
             LOG_DEBUG("Posting message to send queue.");
-            AsyncWrite(msg); // 비동기로 메시지 쓰기 호출
+            m_WriteQueue.push_back(std::move(frame)); // 송신 큐에 프레임 추가
+
+            // 이미 전송 중이면 완료 핸들러에서 이어서 전송
+            if (!m_IsWriting)
+            {
+                AsyncWrite(); // 비동기로 메시지 쓰기 호출
+            }
         });
 }
 
-void UserSession::AsyncWrite(std::shared_ptr<myChatMessage::ChatMessage> msg)
+void UserSession::AsyncWrite()
 {
-    MessageConverter<myChatMessage::ChatMessage>::SerializeMessage(msg, m_Writebuf); // 메시지 직렬화
-    MessageConverter<myChatMessage::ChatMessage>::SetSizeToBufferHeader(m_Writebuf); // 버퍼 헤더에 사이즈 설정
-
-    boost::asio::async_write(m_Socket, boost::asio::buffer(m_Writebuf.data(), m_Writebuf.size()),
-        [this](const boost::system::error_code& err, const size_t transferred)
+    m_IsWriting = true;
+    m_WritingFrames.clear();
+    m_WriteBuffers.clear();
+
+    // 대기 중인 프레임들을 모아 한 번의 gather write로 전송
+    while (!m_WriteQueue.empty() && m_WritingFrames.size() < MAX_GATHER_FRAMES)
+    {
+        m_WritingFrames.push_back(std::move(m_WriteQueue.front()));
+        m_WriteQueue.pop_front();
+
+        const auto& frame = m_WritingFrames.back();
+        m_WriteBuffers.push_back(boost::asio::buffer(frame->data(), frame->size()));
+    }
+
+    // 전송이 끝날 때까지 m_WritingFrames 가 프레임의 참조를 유지
+    boost::asio::async_write(m_Socket, m_WriteBuffers,
+        [this, self = shared_from_this()](const boost::system::error_code& err, const size_t transferred)
         {
+            m_WritingFrames.clear();
+
             if (err)
             {
+                m_IsWriting = false;
+                m_WriteQueue.clear();
                 HandleError("[SERVER] Write Error!!"); // 오류 처리: 쓰기 오류
                 LOG_ERROR("Write Error! %s", err.message().c_str());
+                CloseSocket();
+                return;
+            }
+
+            // 전송 중에 쌓인 프레임이 있으면 이어서 전송
+            if (!m_WriteQueue.empty())
+            {
+                AsyncWrite();
+                return;
+            }
+
+            m_IsWriting = false;
+
+            // 종료 요청이 있었다면 남은 프레임을 모두 보낸 뒤 소켓 정리
+            if (m_CloseAfterWrite)
+            {
+                CloseSocket();
             }
         });
 }
@@ -184,57 +290,114 @@ void UserSession::HandleError(const std::string& errorMessage)
 {
     LOG_ERROR("%s", errorMessage.c_str());
     Close(); // 세션 종료
+    RequestDispatch(); // 서버가 세션 정리를 할 수 있도록 알림
 }
 
-void UserSession::ReadHeader()
+void UserSession::AsyncRead()
 {
-    m_Readbuf.clear(); // 버퍼 초기화
-    m_Readbuf.resize(HEADER_SIZE); // 헤더 크기로 리사이즈
-
-    boost::asio::async_read(m_Socket,
-        boost::asio::buffer(m_Readbuf),
-        [this](const boost::system::error_code& err, const size_t size)
+    // 버퍼 끝까지 데이터가 찼으면 처리되지 않은 데이터를 앞으로 당겨 공간 확보
+    if (m_ReadEnd == m_Readbuf.size())
+    {
+        CompactReadBuffer();
+    }
+
+    // 한 번의 읽기로 들어온 만큼 받아서 완성된 프레임을 모두 처리
+    m_Socket.async_read_some(boost::asio::buffer(m_Readbuf.data() + m_ReadEnd, m_Readbuf.size() - m_ReadEnd),
+        [this, self = shared_from_this()](const boost::system::error_code& err, const size_t size)
         {
-            if (!err)
+            if (err)
             {
-                size_t bodySize = 0;
-                for (int i = 0; i < 4; ++i) {
-                    bodySize += (m_Readbuf[3 - i] << (8 * i)); // 바디 사이즈 계산
+                // 서버가 직접 종료한 세션은 오류로 보지 않음
+                if (IsConnected())
+                {
+                    HandleError("[SERVER] Read Error!!\n" + err.message()); // 오류 처리: 읽기 오류
+                    LOG_ERROR("Read Error!! %s", err.message().c_str());
                 }
-                LOG_DEBUG("Header read successfully, body size: %zu", bodySize);
-                ReadBody(bodySize); // 바디 읽기 호출
+                return;
             }
-            else
+
+            m_ReadEnd += size;
+
+            if (!ProcessReadBuffer())
             {
-                HandleError("[SERVER] Read Header Error!!\n" + err.message()); // 오류 처리: 헤더 읽기 오류
-                LOG_ERROR("Read Header Error!! %s", err.message().c_str());
+                return; // 처리 중 오류로 세션이 종료됨
             }
+
+            AsyncRead(); // 다음 데이터 읽기
         });
 }
 
-void UserSession::ReadBody(size_t bodySize)
+bool UserSession::ProcessReadBuffer()
 {
-    m_Readbuf.clear(); // 버퍼 초기화
-    m_Readbuf.resize(bodySize); // 바디 크기로 리사이즈
+    bool hasMessage = false;
 
-    boost::asio::async_read(m_Socket,
-        boost::asio::buffer(m_Readbuf),
-        [this](std::error_code ec, std::size_t size)
+    // 버퍼에 완성된 프레임이 있는 동안 헤더와 바디를 연속으로 파싱
+    while (m_ReadEnd - m_ReadBegin >= HEADER_SIZE)
+    {
+        size_t bodySize = MessageConverter<myChatMessage::ChatMessage>::GetMessageBodySize(m_Readbuf.data() + m_ReadBegin); // 바디 사이즈 계산
+        if (bodySize > MAX_BODY_SIZE)
         {
-            if (!ec)
+            LOG_ERROR("Body size is too large: %zu", bodySize);
+            HandleError("[SERVER] Invalid Packet Size!!"); // 오류 처리: 잘못된 패킷
+            return false;
+        }
+
+        size_t frameSize = HEADER_SIZE + bodySize;
+        if (m_ReadEnd - m_ReadBegin < frameSize)
+        {
+            // 아직 바디가 다 도착하지 않음, 프레임이 버퍼보다 크면 버퍼 확장
+            if (frameSize > m_Readbuf.size())
             {
-                std::shared_ptr<myChatMessage::ChatMessage> chatMessage = std::make_shared<myChatMessage::ChatMessage>(); // 채팅 메시지 생성
-                if (chatMessage->ParseFromArray(m_Readbuf.data(), static_cast<int>(size))) { // 배열에서 파싱
-                    chatMessage->set_sender(m_UserEntity->GetUserId()); // 발신자 설정
-                    m_InputQueue->push(chatMessage); // 입력 큐에 삽입
-                    LOG_DEBUG("Message received and parsed, sender: %u", m_UserEntity->GetUserId());
-                }
-                ReadHeader(); // 헤더 읽기 호출
+                CompactReadBuffer();
+                m_Readbuf.resize(frameSize);
             }
-            else
+            break;
+        }
+
+        std::shared_ptr<myChatMessage::ChatMessage> chatMessage = ObjectPool<myChatMessage::ChatMessage>::Acquire(); // 채팅 메시지 생성 (풀에서 재사용)
+        if (chatMessage->ParseFromArray(m_Readbuf.data() + m_ReadBegin + HEADER_SIZE, static_cast<int>(bodySize))) { // 배열에서 파싱
+            chatMessage->set_sender(m_UserEntity->GetUserId()); // 발신자 설정
+            // I/O 스레드(생산자)만 넣으므로 락 없이 수신 큐에 삽입
+            if (!m_InboundQueue.TryPush(std::move(chatMessage)))
             {
-                HandleError("[SERVER] Read Body Error!!"); // 오류 처리: 바디 읽기 오류
-                LOG_ERROR("Read Body Error!! %s", ec.message().c_str());
+                // 처리 루프가 따라오지 못할 만큼 메시지를 보내는 세션은 종료
+                ++s_InboundOverflowCount;
+                LOG_WARN("Inbound queue overflow, user: %d, depth: %zu", m_Id, m_InboundQueue.Size());
+                HandleError("[SERVER] Inbound Queue Overflow!!");
+                return false;
             }
-        });
+            LOG_DEBUG("Message received and parsed, sender: %s", m_UserEntity->GetUserId().c_str());
+            hasMessage = true;
+        }
+
+        m_ReadBegin += frameSize;
+    }
+
+    // 모든 데이터를 처리했으면 버퍼 위치 초기화
+    if (m_ReadBegin == m_ReadEnd)
+    {
+        m_ReadBegin = 0;
+        m_ReadEnd = 0;
+    }
+
+    // 이번 읽기에서 받은 메시지들을 한 번에 알림
+    if (hasMessage)
+    {
+        RequestDispatch(); // 서버 처리 루프 깨우기
+    }
+
+    return true;
+}
+
+void UserSession::CompactReadBuffer()
+{
+    // 아직 처리되지 않은 부분 프레임을 버퍼 앞쪽으로 이동
+    size_t remain = m_ReadEnd - m_ReadBegin;
+    if (remain > 0 && m_ReadBegin > 0)
+    {
+        std::memmove(m_Readbuf.data(), m_Readbuf.data() + m_ReadBegin, remain);
+    }
+
+    m_ReadBegin = 0;
+    m_ReadEnd = remain;
 }
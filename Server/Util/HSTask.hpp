@@ -0,0 +1,179 @@
+#pragma once
+#include "Common.h"
+
+// 스레드 풀 작업용 이동 전용 callable 래퍼
+// 캡처가 작은 람다는 내부 버퍼에 그대로 저장하여 std::function 과 달리 힙 할당이 일어나지 않음
+// (std::promise 처럼 복사할 수 없는 객체도 캡처할 수 있음)
+class HSTask
+{
+private:
+    static constexpr size_t INLINE_SIZE = 96;   // 내부 버퍼 크기 (이보다 큰 callable 은 힙에 저장)
+
+    // 저장된 callable 의 타입별 동작
+    struct Operations
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* from, void* to);     // from 의 callable 을 to 로 옮기고 from 은 파괴
+        void (*destroy)(void* storage);
+    };
+
+    template<typename F>
+    static constexpr bool IsInline = sizeof(F) <= INLINE_SIZE
+        && alignof(F) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    static const Operations* GetOperations()
+    {
+        if constexpr (IsInline<F>)
+        {
+            static const Operations ops = {
+                [](void* storage) { (*static_cast<F*>(storage))(); },
+                [](void* from, void* to)
+                {
+                    new (to) F(std::move(*static_cast<F*>(from)));
+                    static_cast<F*>(from)->~F();
+                },
+                [](void* storage) { static_cast<F*>(storage)->~F(); },
+            };
+            return &ops;
+        }
+        else
+        {
+            // 버퍼에는 힙에 할당한 callable 의 포인터만 저장
+            static const Operations ops = {
+                [](void* storage) { (**static_cast<F**>(storage))(); },
+                [](void* from, void* to) { *static_cast<F**>(to) = *static_cast<F**>(from); },
+                [](void* storage) { delete *static_cast<F**>(storage); },
+            };
+            return &ops;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_Storage[INLINE_SIZE];
+    const Operations* m_Ops = nullptr;
+
+public:
+    HSTask() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, HSTask>>>
+    HSTask(F&& func)
+    {
+        using Func = std::decay_t<F>;
+        if constexpr (IsInline<Func>)
+        {
+            new (m_Storage) Func(std::forward<F>(func));
+        }
+        else
+        {
+            *reinterpret_cast<Func**>(m_Storage) = new Func(std::forward<F>(func));
+        }
+        m_Ops = GetOperations<Func>();
+    }
+
+    HSTask(HSTask&& other) noexcept
+    {
+        if (other.m_Ops)
+        {
+            other.m_Ops->move(other.m_Storage, m_Storage);
+            m_Ops = other.m_Ops;
+            other.m_Ops = nullptr;
+        }
+    }
+
+    HSTask& operator=(HSTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            if (other.m_Ops)
+            {
+                other.m_Ops->move(other.m_Storage, m_Storage);
+                m_Ops = other.m_Ops;
+                other.m_Ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    HSTask(const HSTask&) = delete;
+    HSTask& operator=(const HSTask&) = delete;
+
+    ~HSTask() { Reset(); }
+
+    explicit operator bool() const { return m_Ops != nullptr; }
+
+    void operator()() { m_Ops->invoke(m_Storage); }
+
+    void Reset()
+    {
+        if (m_Ops)
+        {
+            m_Ops->destroy(m_Storage);
+            m_Ops = nullptr;
+        }
+    }
+};
+
+// std::promise 의 공유 상태를 재사용하기 위한 할당자 (타입별 여유 블록 목록을 보관)
+template<typename T>
+struct SharedStateAllocator
+{
+    using value_type = T;
+
+    SharedStateAllocator() = default;
+    template<typename U>
+    SharedStateAllocator(const SharedStateAllocator<U>&) {}
+
+    T* allocate(size_t n)
+    {
+        if (n == 1)
+        {
+            auto& freeList = GetFreeList();
+            std::scoped_lock lock(freeList.mutex);
+            if (!freeList.blocks.empty())
+            {
+                void* block = freeList.blocks.back();
+                freeList.blocks.pop_back();
+                return static_cast<T*>(block);
+            }
+        }
+        return static_cast<T*>(::operator new(sizeof(T) * n));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        if (n == 1)
+        {
+            auto& freeList = GetFreeList();
+            std::scoped_lock lock(freeList.mutex);
+            if (freeList.blocks.size() < MAX_FREE_COUNT)
+            {
+                freeList.blocks.push_back(p);
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+    template<typename U>
+    bool operator==(const SharedStateAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const SharedStateAllocator<U>&) const { return false; }
+
+private:
+    static constexpr size_t MAX_FREE_COUNT = 1024;
+
+    struct FreeList
+    {
+        std::mutex mutex;
+        std::vector<void*> blocks;
+    };
+
+    // 종료 시 아직 살아 있는 future 가 해제된 목록에 반환되지 않도록 소멸시키지 않음
+    static FreeList& GetFreeList()
+    {
+        static FreeList* freeList = new FreeList();
+        return *freeList;
+    }
+};
@@ -1,34 +1,212 @@
 #pragma once
 #include "Common.h"
+#include "Util/MpmcRingBuffer.hpp"
+#include "Util/HSTask.hpp"
+#include "Util/HsLogger.hpp"
 
+// 작업 우선순위 (값이 작을수록 먼저 처리)
+enum class JobPriority : uint8_t
+{
+    High = 0,       // 로그인 검증처럼 지연에 민감한 작업
+    Normal,         // 일반 DB 작업
+    Low,            // 대량/배치 작업
+    Count
+};
+
+// 작업 제출 옵션
+struct JobOptions
+{
+    JobPriority priority = JobPriority::Normal;
+    std::chrono::milliseconds timeout{ 0 };     // 대기 시간이 이보다 길어지면 실행하지 않음 (0 이면 제한 없음)
+};
+
+// 마이크로초 단위 지연 시간을 2의 거듭제곱 구간으로 세는 히스토그램 (원자적 카운터만 사용하므로 항상 켜 둘 수 있음)
+class LatencyHistogram
+{
+public:
+    static constexpr size_t BUCKET_COUNT = 32;  // i 번째 구간: [2^(i-1), 2^i) 마이크로초 (0 번은 1us 미만)
+
+    void Record(uint64_t us)
+    {
+        size_t bucket = 0;
+        while (us > 0 && bucket < BUCKET_COUNT - 1)
+        {
+            us >>= 1;
+            ++bucket;
+        }
+        m_Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 백분위(0~100)에 해당하는 구간의 상한값 (마이크로초)
+    uint64_t Percentile(uint32_t percentile) const
+    {
+        std::array<uint64_t, BUCKET_COUNT> counts;
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            counts[i] = m_Buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        if (total == 0)
+        {
+            return 0;
+        }
+
+        uint64_t target = (total * percentile + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            seen += counts[i];
+            if (seen >= target)
+            {
+                return uint64_t(1) << i;
+            }
+        }
+        return uint64_t(1) << (BUCKET_COUNT - 1);
+    }
+
+    uint64_t Count() const
+    {
+        uint64_t total = 0;
+        for (const auto& bucket : m_Buckets)
+        {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_Buckets{};
+};
+
+// 워커마다 작업 덱을 두고, 외부에서 들어온 작업은 우선순위별 락 없는 주입 큐로 받는 작업 훔치기(work-stealing) 스레드 풀
+// - 워커가 넣은 일반 작업은 자기 덱 뒤에 넣고 뒤에서 꺼냄 (캐시 지역성)
+// - 할 일을 찾을 때는 High 큐 -> 자기 덱 -> Normal 큐 -> 다른 워커 덱 -> Low 큐 순서로 확인
 class HSThreadPool
 {
+public:
+    // 우선순위별 대기 시간 통계
+    struct LaneStats
+    {
+        uint64_t executedCount;     // 실행된 작업 수
+        uint64_t expiredCount;      // 기한이 지나 실행하지 않은 작업 수
+        uint64_t totalWaitUs;       // 큐 대기 시간 합 (마이크로초)
+        uint64_t maxWaitUs;         // 최대 큐 대기 시간 (마이크로초)
+    };
+
+    // 스레드 풀 전체 상태
+    struct PoolStats
+    {
+        size_t workerCount;         // 워커 수
+        size_t busyWorkers;         // 작업을 실행 중인 워커 수
+        size_t queueDepth;          // 꺼내지 않은 작업 수
+        size_t peakQueueDepth;      // 마지막 조회 이후 최대 작업 수
+        uint64_t waitP50Us;         // 큐 대기 시간 백분위 (구간 상한, 마이크로초)
+        uint64_t waitP99Us;
+        uint64_t runP50Us;          // 실행 시간 백분위 (구간 상한, 마이크로초)
+        uint64_t runP99Us;
+        uint64_t completedJobs;     // 실행이 끝난 작업 수 (기한이 지나 버린 작업 제외)
+    };
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        HSTask task;
+        JobPriority priority = JobPriority::Normal;
+        Clock::time_point enqueueTime;
+    };
+
+    // 워커별 작업 덱 (주인 워커와 훔쳐가는 워커만 접근하므로 경합이 적음)
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // 우선순위별 주입 큐와 통계
+    struct Lane
+    {
+        explicit Lane(size_t capacity) : queue(capacity) {}
+
+        MpmcRingBuffer<Job> queue;
+        std::mutex overflowMutex;               // 주입 큐가 가득 찼을 때 쓰는 예비 큐 (같은 우선순위 유지)
+        std::deque<Job> overflow;
+        std::atomic<size_t> overflowCount = 0;
+        std::atomic<uint64_t> executedCount = 0;
+        std::atomic<uint64_t> expiredCount = 0;
+        std::atomic<uint64_t> totalWaitUs = 0;
+        std::atomic<uint64_t> maxWaitUs = 0;
+    };
+
+    static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(JobPriority::Count);
+    static constexpr size_t INJECTION_QUEUE_SIZE = 4096;
+    static constexpr size_t POP_RETRY_COUNT = 16;                           // 대기 작업을 꺼내지 못했을 때 양보하며 다시 시도하는 횟수
+    static constexpr std::chrono::milliseconds POP_RETRY_WAIT{ 1 };         // 다시 시도해도 꺼내지 못했을 때 잠드는 시간
+
     // 스레드 풀의 스레드 개수
     size_t m_Threads;
     // 스레드 풀의 워커 스레드들
     std::vector<std::thread> m_Workers;
 
-    // 작업 큐
-    std::queue<std::function<void()>> m_Jobs;
-    // 작업을 조정하기 위한 조건 변수와 뮤텍스
+    // 워커별 작업 덱
+    std::vector<std::unique_ptr<WorkerQueue>> m_WorkerQueues;
+    // 외부 스레드가 넣는 우선순위별 작업 큐 (가득 차면 같은 우선순위의 예비 큐에 넣음)
+    std::array<std::unique_ptr<Lane>, PRIORITY_COUNT> m_Lanes;
+
+    // 아직 꺼내지 않은 작업 수 (워커를 재울지 판단하는 기준)
+    std::atomic<size_t> m_PendingJobs;
+    // 마지막 조회 이후 최대 대기 작업 수
+    std::atomic<size_t> m_PeakPendingJobs;
+    // 작업을 실행 중인 워커 수
+    std::atomic<size_t> m_BusyWorkers;
+    // 작업별 큐 대기 시간과 실행 시간 분포
+    LatencyHistogram m_WaitHistogram;
+    LatencyHistogram m_RunHistogram;
+    // 잠들어 있거나 잠들려는 워커 수 (0 이면 깨우기 생략)
+    std::atomic<size_t> m_IdleWorkers;
+    // 할 일이 없는 워커를 재우기 위한 조건 변수와 뮤텍스
     std::condition_variable m_CVJob;
     std::mutex m_JobMutex;
 
     // 스레드 풀을 멈추기 위한 플래그
-    bool m_StopAll;
+    std::atomic<bool> m_StopAll;
+
+    // 현재 스레드가 이 풀의 워커라면 자신의 풀과 덱 인덱스
+    static inline thread_local HSThreadPool* t_Pool = nullptr;
+    static inline thread_local size_t t_WorkerIndex = 0;
+    // 현재 워커가 실행한 작업이 기한이 지나 버려졌는지 (대기 시간 통계에서 제외)
+    static inline thread_local bool t_JobExpired = false;
 
 public:
     // 생성자: 주어진 스레드 개수만큼의 워커 스레드를 생성합니다.
     HSThreadPool(size_t num_threads)
-        : m_Threads(num_threads), m_StopAll(false)
+        : m_Threads(std::max<size_t>(1, num_threads))
+        , m_PendingJobs(0)
+        , m_PeakPendingJobs(0)
+        , m_BusyWorkers(0)
+        , m_IdleWorkers(0)
+        , m_StopAll(false)
     {
+        for (auto& lane : m_Lanes)
+        {
+            lane = std::make_unique<Lane>(INJECTION_QUEUE_SIZE);
+        }
+
+        m_WorkerQueues.reserve(m_Threads);
+        for (size_t i = 0; i < m_Threads; ++i)
+        {
+            m_WorkerQueues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+
         m_Workers.reserve(m_Threads);
 
         // 각 스레드에 대해 Start() 함수를 실행하는 람다 함수를 생성하여 스레드를 생성합니다.
         for (size_t i = 0; i < m_Threads; ++i)
         {
-            m_Workers.emplace_back([this]() { this->Start(); });
+            m_Workers.emplace_back([this, i]() { this->Start(i); });
         }
     }
 
@@ -36,7 +214,10 @@ public:
     ~HSThreadPool()
     {
         // 모든 워커 스레드에게 종료 신호를 보냅니다.
-        m_StopAll = true;
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_StopAll = true;
+        }
 
         // 모든 스레드에게 작업이 없음을 알리고 깨웁니다.
         m_CVJob.notify_all();
@@ -49,6 +230,7 @@ public:
     }
 
     // 작업을 큐에 추가하고, 해당 작업의 결과를 반환하는 함수입니다.
+    // promise 를 작업 안에 직접 담고 공유 상태는 재사용하므로 작은 작업은 힙 할당 없이 제출됩니다.
     template <class F, class... Args>
     auto EnqueueJob(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type>
     {
@@ -58,43 +240,303 @@ public:
         }
 
         using return_type = typename std::invoke_result<F, Args...>::type;
-        auto job = std::make_shared<std::packaged_task<return_type()>>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::promise<return_type> promise(std::allocator_arg, SharedStateAllocator<return_type>());
+        std::future<return_type> job_result_future = promise.get_future();
+
+        Push(JobPriority::Normal, [func = std::forward<F>(f), params = std::make_tuple(std::forward<Args>(args)...), promise = std::move(promise)]() mutable
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<return_type>)
+                    {
+                        std::apply(func, std::move(params));
+                        promise.set_value();
+                    }
+                    else
+                    {
+                        promise.set_value(std::apply(func, std::move(params)));
+                    }
+                }
+                catch (...)
+                {
+                    promise.set_exception(std::current_exception());
+                }
+            });
+        return job_result_future;
+    }
 
-        std::future<return_type> job_result_future = job->get_future();
+    // 결과가 필요 없는 작업을 큐에 추가하는 함수입니다. (future 를 만들지 않음)
+    template <class F>
+    void PostJob(F&& f)
+    {
+        if (m_StopAll)
         {
-            std::lock_guard<std::mutex> lock(m_JobMutex);
-            m_Jobs.push([job]() { (*job)(); });
+            throw std::runtime_error("ThreadPool is Stoped");
         }
 
-        m_CVJob.notify_one();
-        return job_result_future;
+        Push(JobPriority::Normal, HSTask(std::forward<F>(f)));
+    }
+
+    // 우선순위를 지정하여 결과가 필요 없는 작업을 큐에 추가하는 함수입니다.
+    // 기한이 지난 작업은 실행하지 않고 onExpired 를 호출하여 요청자에게 바로 실패를 알립니다.
+    template <class F, class E>
+    void PostJob(const JobOptions& options, F&& f, E&& onExpired)
+    {
+        if (m_StopAll)
+        {
+            throw std::runtime_error("ThreadPool is Stoped");
+        }
+
+        if (options.timeout.count() <= 0)
+        {
+            Push(options.priority, HSTask(std::forward<F>(f)));
+            return;
+        }
+
+        Push(options.priority, [this, priority = options.priority, deadline = Clock::now() + options.timeout, func = std::forward<F>(f), onExpired = std::forward<E>(onExpired)]() mutable
+            {
+                if (Clock::now() > deadline)
+                {
+                    t_JobExpired = true;
+                    ++m_Lanes[static_cast<size_t>(priority)]->expiredCount;
+                    onExpired();
+                    return;
+                }
+
+                func();
+            });
+    }
+
+    template <class F>
+    void PostJob(const JobOptions& options, F&& f)
+    {
+        PostJob(options, std::forward<F>(f), []() {});
+    }
+
+    // 우선순위별 큐 대기 시간 통계를 반환합니다.
+    LaneStats GetLaneStats(JobPriority priority) const
+    {
+        const auto& lane = *m_Lanes[static_cast<size_t>(priority)];
+        return { lane.executedCount.load(), lane.expiredCount.load(), lane.totalWaitUs.load(), lane.maxWaitUs.load() };
+    }
+
+    // 큐 깊이, 실행 중인 워커 수, 대기/실행 시간 분포를 반환합니다. (최대 큐 깊이는 조회할 때마다 초기화)
+    PoolStats GetStats()
+    {
+        PoolStats stats;
+        stats.workerCount = m_Threads;
+        stats.busyWorkers = m_BusyWorkers.load();
+        stats.queueDepth = m_PendingJobs.load();
+        stats.peakQueueDepth = m_PeakPendingJobs.exchange(stats.queueDepth);
+        stats.waitP50Us = m_WaitHistogram.Percentile(50);
+        stats.waitP99Us = m_WaitHistogram.Percentile(99);
+        stats.runP50Us = m_RunHistogram.Percentile(50);
+        stats.runP99Us = m_RunHistogram.Percentile(99);
+        stats.completedJobs = m_RunHistogram.Count();
+        return stats;
     }
 
 private:
+    // 작업을 알맞은 큐에 넣고 잠든 워커를 깨웁니다.
+    void Push(JobPriority priority, HSTask&& task)
+    {
+        Job job{ std::move(task), priority, Clock::now() };
+
+        // 꺼내는 쪽이 먼저 감소시키지 않도록 넣기 전에 증가
+        size_t pending = m_PendingJobs.fetch_add(1) + 1;
+        size_t peak = m_PeakPendingJobs.load(std::memory_order_relaxed);
+        while (pending > peak && !m_PeakPendingJobs.compare_exchange_weak(peak, pending, std::memory_order_relaxed))
+        {
+        }
+
+        if (t_Pool == this && priority == JobPriority::Normal)
+        {
+            // 워커 스레드에서 넣는 일반 작업은 자기 덱 뒤에 추가
+            auto& queue = *m_WorkerQueues[t_WorkerIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+        else
+        {
+            auto& lane = *m_Lanes[static_cast<size_t>(priority)];
+            if (!lane.queue.TryPush(std::move(job)))
+            {
+                // 주입 큐가 가득 차면 같은 우선순위의 예비 큐에 추가 (우선순위를 잃지 않도록 워커 덱에는 넣지 않음)
+                std::lock_guard<std::mutex> lock(lane.overflowMutex);
+                lane.overflow.push_back(std::move(job));
+                ++lane.overflowCount;
+            }
+        }
+
+        // 잠든 워커가 있을 때만 깨움 (뮤텍스를 거쳐 대기 직전의 워커가 알림을 놓치지 않도록 함)
+        if (m_IdleWorkers.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_JobMutex);
+            }
+            m_CVJob.notify_one();
+        }
+    }
+
+    bool TryPopLane(JobPriority priority, Job& job)
+    {
+        auto& lane = *m_Lanes[static_cast<size_t>(priority)];
+        if (lane.queue.TryPop(job))
+        {
+            return true;
+        }
+
+        // 예비 큐는 비어 있으면 잠그지 않음
+        if (lane.overflowCount.load() == 0)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(lane.overflowMutex);
+        if (lane.overflow.empty())
+        {
+            return false;
+        }
+        job = std::move(lane.overflow.front());
+        lane.overflow.pop_front();
+        --lane.overflowCount;
+        return true;
+    }
+
+    // High 큐 -> 자기 덱 -> Normal 큐 -> 다른 워커 덱 -> Low 큐 순서로 작업을 찾습니다.
+    bool TryPop(size_t index, Job& job)
+    {
+        if (TryPopLane(JobPriority::High, job))
+        {
+            return true;
+        }
+
+        {
+            auto& queue = *m_WorkerQueues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+                return true;
+            }
+        }
+
+        if (TryPopLane(JobPriority::Normal, job))
+        {
+            return true;
+        }
+
+        // 다른 워커 덱의 앞(가장 오래된 작업)에서 훔쳐옴, 사용 중인 덱은 건너뜀
+        for (size_t i = 1; i < m_Threads; ++i)
+        {
+            auto& victim = *m_WorkerQueues[(index + i) % m_Threads];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (lock.owns_lock() && !victim.jobs.empty())
+            {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+
+        return TryPopLane(JobPriority::Low, job);
+    }
+
+    static uint64_t ElapsedUs(Clock::time_point from, Clock::time_point to)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+    }
+
+    // 실행한 작업의 큐 대기 시간을 우선순위별로 기록합니다.
+    void RecordWait(JobPriority priority, uint64_t waitUs)
+    {
+        auto& lane = *m_Lanes[static_cast<size_t>(priority)];
+        m_WaitHistogram.Record(waitUs);
+
+        ++lane.executedCount;
+        lane.totalWaitUs += waitUs;
+
+        uint64_t maxWaitUs = lane.maxWaitUs.load();
+        while (waitUs > maxWaitUs && !lane.maxWaitUs.compare_exchange_weak(maxWaitUs, waitUs))
+        {
+        }
+    }
+
     // 워커 스레드가 실제로 실행하는 함수입니다.
-    void Start()
+    void Start(size_t index)
     {
+        t_Pool = this;
+        t_WorkerIndex = index;
+        size_t popMissCount = 0;
+
         while (true)
         {
-            std::unique_lock<std::mutex> lock(m_JobMutex);
+            Job job;
+            if (TryPop(index, job))
+            {
+                popMissCount = 0;
+                m_PendingJobs.fetch_sub(1);
+                ++m_BusyWorkers;
 
-            // 작업이 없고 스레드 풀이 종료되었으면 대기합니다.
-            m_CVJob.wait(lock, [this]() { return !this->m_Jobs.empty() || m_StopAll; });
+                auto startTime = Clock::now();
+                t_JobExpired = false;
+
+                // 작업을 실행합니다. (PostJob 작업은 결과를 받을 곳이 없으므로 예외는 로그로만 남김)
+                try
+                {
+                    job.task();
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("Exception in thread pool job : %s", e.what());
+                }
+                catch (...)
+                {
+                    LOG_ERROR("Unknown exception in thread pool job");
+                }
+
+                // 기한이 지나 실행하지 않은 작업은 expiredCount 로만 집계 (대기/실행 시간 분포에서 제외)
+                if (!t_JobExpired)
+                {
+                    RecordWait(job.priority, ElapsedUs(job.enqueueTime, startTime));
+                    m_RunHistogram.Record(ElapsedUs(startTime, Clock::now()));
+                }
+                --m_BusyWorkers;
+                continue;
+            }
+
+            // 대기 작업이 남아 있는데 꺼내지 못한 경우 (다른 스레드가 넣는 중이거나 훔치려는 덱이 사용 중)
+            // 아래 조건 변수 대기는 바로 깨어나므로, 몇 번 양보하며 다시 시도한 뒤 짧게 잠들어 헛돌지 않게 함
+            if (m_PendingJobs.load() > 0)
+            {
+                if (++popMissCount < POP_RETRY_COUNT)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                popMissCount = 0;
+
+                std::unique_lock<std::mutex> lock(m_JobMutex);
+                ++m_IdleWorkers;
+                m_CVJob.wait_for(lock, POP_RETRY_WAIT);
+                --m_IdleWorkers;
+                continue;
+            }
+            popMissCount = 0;
+
+            std::unique_lock<std::mutex> lock(m_JobMutex);
 
             // 스레드 풀이 종료되고 작업이 없으면 종료합니다.
-            if (m_StopAll && this->m_Jobs.empty())
+            if (m_StopAll && m_PendingJobs.load() == 0)
             {
                 return;
             }
 
-            // 작업을 꺼내옵니다.
-            std::function<void()> job = std::move(m_Jobs.front());
-            m_Jobs.pop();
-            lock.unlock();
-
-            // 작업을 실행합니다.
-            std::cout << "Worker pop() : threadID -> " << std::this_thread::get_id() << std::endl;
-            job();
+            // 작업이 없으면 대기합니다. (훔치기에서 사용 중인 덱을 건너뛴 경우를 대비해 주기적으로 다시 확인)
+            ++m_IdleWorkers;
+            m_CVJob.wait_for(lock, std::chrono::milliseconds(100), [this]() { return m_PendingJobs.load() > 0 || m_StopAll; });
+            --m_IdleWorkers;
         }
     }
-};
\ No newline at end of file
+};
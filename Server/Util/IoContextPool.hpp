@@ -0,0 +1,88 @@
+#pragma once
+#include "Common.h"
+
+class IoContextPool
+{
+private:
+    using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+
+    // 스레드마다 하나씩 사용하는 I/O 컨텍스트
+    std::vector<std::unique_ptr<boost::asio::io_context>> m_IoContexts;
+    // 처리할 작업이 없어도 run()이 반환되지 않도록 유지하는 가드
+    std::vector<WorkGuard> m_WorkGuards;
+    // 각 I/O 컨텍스트를 실행하는 스레드들
+    std::vector<std::thread> m_Threads;
+
+    // 세션을 라운드로빈으로 분배하기 위한 인덱스
+    std::atomic<size_t> m_NextIndex;
+
+public:
+    // 생성자: 주어진 개수만큼 I/O 컨텍스트를 생성합니다. (0 이면 코어 수만큼 생성)
+    explicit IoContextPool(size_t poolSize)
+        : m_NextIndex(0)
+    {
+        if (poolSize == 0)
+        {
+            poolSize = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        m_IoContexts.reserve(poolSize);
+        m_WorkGuards.reserve(poolSize);
+        for (size_t i = 0; i < poolSize; ++i)
+        {
+            m_IoContexts.emplace_back(std::make_unique<boost::asio::io_context>(1));
+            m_WorkGuards.emplace_back(boost::asio::make_work_guard(*m_IoContexts.back()));
+        }
+    }
+
+    // 소멸자: 실행 중인 모든 I/O 스레드를 정리합니다.
+    ~IoContextPool()
+    {
+        Stop();
+    }
+
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+
+    // 각 I/O 컨텍스트를 전용 스레드에서 실행합니다.
+    void Run()
+    {
+        m_Threads.reserve(m_IoContexts.size());
+        for (auto& ioContext : m_IoContexts)
+        {
+            m_Threads.emplace_back([&ioContext]() { ioContext->run(); });
+        }
+    }
+
+    // 모든 I/O 컨텍스트를 멈추고 스레드가 종료될 때까지 대기합니다.
+    void Stop()
+    {
+        m_WorkGuards.clear();
+
+        for (auto& ioContext : m_IoContexts)
+        {
+            ioContext->stop();
+        }
+
+        for (auto& t : m_Threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+        m_Threads.clear();
+    }
+
+    // 다음 세션이 사용할 I/O 컨텍스트를 라운드로빈으로 반환합니다.
+    boost::asio::io_context& GetNextIoContext()
+    {
+        size_t index = m_NextIndex.fetch_add(1, std::memory_order_relaxed) % m_IoContexts.size();
+        return *m_IoContexts[index];
+    }
+
+    size_t Size() const
+    {
+        return m_IoContexts.size();
+    }
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include "Common.h"
+
+// 다중 생산자/다중 소비자 고정 크기 링 버퍼 (락 없음)
+// 슬롯마다 시퀀스 번호를 두어 생산자와 소비자가 CAS 한 번으로 자리를 확보합니다.
+template<typename T>
+class MpmcRingBuffer
+{
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;   // 슬롯 상태 (pos: 비어 있음, pos + 1: 채워짐)
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> m_Slots;                    // 요소 저장 공간 (크기는 2의 거듭제곱)
+    size_t m_Mask;                                      // 인덱스를 버퍼 크기로 감싸기 위한 마스크
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_EnqueuePos;  // 다음에 넣을 위치
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_DequeuePos;  // 다음에 꺼낼 위치
+
+public:
+    // 생성자: 용량을 2의 거듭제곱으로 올려서 버퍼를 할당합니다.
+    explicit MpmcRingBuffer(size_t capacity)
+        : m_EnqueuePos(0)
+        , m_DequeuePos(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        m_Slots = std::make_unique<Slot[]>(size);
+        m_Mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+        {
+            m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // 복사 생성자와 대입 연산자를 삭제하여 복사를 금지
+    MpmcRingBuffer(const MpmcRingBuffer<T>&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer<T>&) = delete;
+
+    // 가득 차 있으면 false 를 반환하고 item 은 그대로 둡니다.
+    bool TryPush(T&& item)
+    {
+        size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = m_Slots[pos & m_Mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // 빈 슬롯: 위치를 선점하면 값을 기록
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(item);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 한 바퀴 전의 값이 아직 소비되지 않음 (가득 참)
+            }
+            else
+            {
+                pos = m_EnqueuePos.load(std::memory_order_relaxed); // 다른 생산자가 먼저 가져감
+            }
+        }
+    }
+
+    // 비어 있으면 false 를 반환합니다.
+    bool TryPop(T& item)
+    {
+        size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = m_Slots[pos & m_Mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                // 채워진 슬롯: 위치를 선점하면 값을 꺼내고 다음 바퀴를 위해 비움
+                if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    item = std::move(slot.value);
+                    slot.value = T();
+                    slot.sequence.store(pos + m_Mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 비어 있음
+            }
+            else
+            {
+                pos = m_DequeuePos.load(std::memory_order_relaxed); // 다른 소비자가 먼저 가져감
+            }
+        }
+    }
+
+    size_t Capacity() const
+    {
+        return m_Mask + 1;
+    }
+};
@@ -0,0 +1,172 @@
+#pragma once
+#include "Common.h"
+
+// 풀에 반환될 때 객체를 재사용 가능한 상태로 되돌리는 방법 (기본: 프로토콜 버퍼 메시지의 Clear)
+// Clear 는 문자열 필드의 용량을 유지하므로 재사용 시 필드 할당이 다시 일어나지 않음
+template<typename T>
+struct PooledObjectTraits
+{
+    static void Reset(T& obj) { obj.Clear(); }
+};
+
+// 송신 프레임 버퍼: 용량은 유지하되 큰 프레임으로 늘어난 버퍼는 반납
+template<>
+struct PooledObjectTraits<std::vector<uint8_t>>
+{
+    static constexpr size_t MAX_POOLED_CAPACITY = 16 * 1024;
+
+    static void Reset(std::vector<uint8_t>& buffer)
+    {
+        buffer.clear();
+        if (buffer.capacity() > MAX_POOLED_CAPACITY)
+        {
+            buffer.shrink_to_fit();
+        }
+    }
+};
+
+// shared_ptr 로 빌려주고, 마지막 참조가 사라지면 객체와 제어 블록을 모두 풀로 돌려받는 객체 풀
+// 정상 상태에서는 Acquire 한 번에 힙 할당이 일어나지 않음
+template<typename T>
+class ObjectPool
+{
+public:
+    struct Stats
+    {
+        uint64_t acquireCount;      // Acquire 호출 수
+        uint64_t objectAllocCount;  // 풀이 비어 새로 만든 객체 수
+        uint64_t blockAllocCount;   // 풀이 비어 새로 할당한 제어 블록 수
+    };
+
+    // 프로세스 종료 시 남아 있는 핸들이 해제된 풀에 반환되지 않도록 풀 자체는 소멸시키지 않음
+    static ObjectPool& Instance()
+    {
+        static ObjectPool* pool = new ObjectPool();
+        return *pool;
+    }
+
+    static std::shared_ptr<T> Acquire()
+    {
+        return Instance().AcquireObject();
+    }
+
+    Stats GetStats() const
+    {
+        return { m_AcquireCount.load(), m_ObjectAllocCount.load(), m_BlockAllocCount.load() };
+    }
+
+private:
+    // 마지막 참조가 사라지면 객체를 풀로 반환
+    struct Deleter
+    {
+        void operator()(T* obj) const { ObjectPool::Instance().ReleaseObject(obj); }
+    };
+
+    // shared_ptr 제어 블록을 풀에서 할당하는 할당자
+    template<typename U>
+    struct BlockAllocator
+    {
+        using value_type = U;
+
+        BlockAllocator() = default;
+        template<typename V>
+        BlockAllocator(const BlockAllocator<V>&) {}
+
+        U* allocate(size_t n) { return static_cast<U*>(ObjectPool::Instance().AllocateBlock(sizeof(U) * n)); }
+        void deallocate(U* p, size_t n) { ObjectPool::Instance().FreeBlock(p, sizeof(U) * n); }
+
+        template<typename V>
+        bool operator==(const BlockAllocator<V>&) const { return true; }
+        template<typename V>
+        bool operator!=(const BlockAllocator<V>&) const { return false; }
+    };
+
+    static constexpr size_t MAX_FREE_COUNT = 4096;  // 풀에 보관할 최대 여유 객체/블록 수
+
+    std::mutex m_Mutex;
+    std::vector<T*> m_FreeObjects;          // 재사용 대기 중인 객체
+    std::vector<void*> m_FreeBlocks;        // 재사용 대기 중인 제어 블록
+    size_t m_BlockSize = 0;                 // 제어 블록 크기 (첫 할당 시 결정)
+
+    std::atomic<uint64_t> m_AcquireCount = 0;
+    std::atomic<uint64_t> m_ObjectAllocCount = 0;
+    std::atomic<uint64_t> m_BlockAllocCount = 0;
+
+    ObjectPool()
+    {
+        m_FreeObjects.reserve(MAX_FREE_COUNT);
+        m_FreeBlocks.reserve(MAX_FREE_COUNT);
+    }
+
+    std::shared_ptr<T> AcquireObject()
+    {
+        T* obj = nullptr;
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (!m_FreeObjects.empty())
+            {
+                obj = m_FreeObjects.back();
+                m_FreeObjects.pop_back();
+            }
+        }
+
+        ++m_AcquireCount;
+        if (!obj)
+        {
+            obj = new T();
+            ++m_ObjectAllocCount;
+        }
+
+        return std::shared_ptr<T>(obj, Deleter(), BlockAllocator<T>());
+    }
+
+    void ReleaseObject(T* obj)
+    {
+        PooledObjectTraits<T>::Reset(*obj);
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (m_FreeObjects.size() < MAX_FREE_COUNT)
+            {
+                m_FreeObjects.push_back(obj);
+                return;
+            }
+        }
+
+        delete obj;
+    }
+
+    void* AllocateBlock(size_t size)
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (m_BlockSize == 0)
+            {
+                m_BlockSize = size;
+            }
+
+            if (size == m_BlockSize && !m_FreeBlocks.empty())
+            {
+                void* block = m_FreeBlocks.back();
+                m_FreeBlocks.pop_back();
+                return block;
+            }
+        }
+
+        ++m_BlockAllocCount;
+        return ::operator new(size);
+    }
+
+    void FreeBlock(void* block, size_t size)
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (size == m_BlockSize && m_FreeBlocks.size() < MAX_FREE_COUNT)
+            {
+                m_FreeBlocks.push_back(block);
+                return;
+            }
+        }
+
+        ::operator delete(block);
+    }
+};
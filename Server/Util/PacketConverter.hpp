@@ -1,6 +1,10 @@
 #pragma once
 #include "Message/MyMessage.pb.h"
 #include "Common.h"
+#include "Util/ObjectPool.hpp"
+
+// 헤더와 바디가 모두 직렬화된 송신용 프레임 (여러 세션이 공유하므로 수정 불가)
+using EncodedFrame = std::shared_ptr<const std::vector<uint8_t>>;
 
 template <typename T>
 class MessageConverter
@@ -21,6 +25,17 @@ public:
         return message->SerializePartialToArray(buffer.data() + HEADER_SIZE, size);
     }
 
+    // 메시지를 한 번만 직렬화하여 헤더가 포함된 공유 프레임을 만드는 함수 (버퍼는 풀에서 재사용)
+    static EncodedFrame EncodeFrame(const std::shared_ptr<T>& message)
+    {
+        auto buffer = ObjectPool<std::vector<uint8_t>>::Acquire();
+        size_t size = GetMessageSize(message);
+        buffer->resize(HEADER_SIZE + size);
+        message->SerializePartialToArray(buffer->data() + HEADER_SIZE, static_cast<int>(size));
+        SetSizeToBufferHeader(*buffer);
+        return buffer;
+    }
+
     // 바이트 버퍼의 헤더에 메시지 크기를 설정하는 함수
     static bool SetSizeToBufferHeader(std::vector<uint8_t>& buffer)
     {
@@ -47,11 +62,17 @@ public:
 
     // 바이트 버퍼에서 추출한 메시지 바디의 크기를 반환하는 함수
     static size_t GetMessageBodySize(const std::vector<uint8_t>& buffer)
+    {
+        return GetMessageBodySize(buffer.data());
+    }
+
+    // 헤더 포인터에서 빅 엔디안으로 기록된 메시지 바디의 크기를 반환하는 함수
+    static size_t GetMessageBodySize(const uint8_t* header)
     {
         size_t size = 0;
         for (int i = 0; i < HEADER_SIZE; i++)
         {
-            size = static_cast<size_t>(buffer[i]);
+            size = (size << 8) | static_cast<size_t>(header[i]);
         }
 
         return size;
@@ -0,0 +1,74 @@
+#pragma once
+#include "Common.h"
+#include <future>
+
+// 같은 키에 대한 동시 조회를 하나로 합치는 클래스
+// 먼저 들어온 호출이 조회를 실행하고, 실행 중에 같은 키로 들어온 호출은 그 결과(또는 예외)를 함께 받습니다.
+template<typename Key, typename Value>
+class SingleFlight
+{
+public:
+    struct Stats
+    {
+        uint64_t executedCount;     // 실제로 조회를 실행한 수
+        uint64_t sharedCount;       // 실행 중인 조회의 결과를 공유받은 수
+    };
+
+    template<typename Func>
+    Value Do(const Key& key, Func&& func)
+    {
+        std::promise<Value> promise;
+        std::shared_future<Value> inFlight;
+        {
+            std::scoped_lock lock(m_Mutex);
+            auto it = m_Calls.find(key);
+            if (it != m_Calls.end())
+            {
+                inFlight = it->second;
+            }
+            else
+            {
+                m_Calls.emplace(key, promise.get_future().share());
+            }
+        }
+
+        // 이미 실행 중인 조회가 있으면 잠금 밖에서 그 결과를 기다림
+        if (inFlight.valid())
+        {
+            ++m_SharedCount;
+            return inFlight.get();
+        }
+
+        ++m_ExecutedCount;
+        try
+        {
+            promise.set_value(func());
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+        }
+
+        // 결과가 정해진 뒤에 목록에서 제거 (이후 호출은 새로 조회)
+        std::shared_future<Value> result;
+        {
+            std::scoped_lock lock(m_Mutex);
+            auto it = m_Calls.find(key);
+            result = std::move(it->second);
+            m_Calls.erase(it);
+        }
+        return result.get();
+    }
+
+    Stats GetStats() const
+    {
+        return { m_ExecutedCount.load(), m_SharedCount.load() };
+    }
+
+private:
+    std::mutex                                          m_Mutex;
+    std::unordered_map<Key, std::shared_future<Value>>  m_Calls;    // 실행 중인 조회 (키별 결과)
+
+    std::atomic<uint64_t>                               m_ExecutedCount = 0;
+    std::atomic<uint64_t>                               m_SharedCount = 0;
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include "Common.h"
+
+// 단일 생산자/단일 소비자 전용 고정 크기 링 버퍼 (락 없음)
+// 생산자 스레드는 TryPush 만, 소비자 스레드는 TryPop 만 호출해야 합니다.
+template<typename T>
+class SpscRingBuffer
+{
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<T> m_Buffer;                            // 요소 저장 공간 (크기는 2의 거듭제곱)
+    size_t m_Mask;                                      // 인덱스를 버퍼 크기로 감싸기 위한 마스크
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Head;    // 다음에 꺼낼 위치 (소비자가 갱신)
+    size_t m_CachedTail;                                    // 소비자가 마지막으로 읽은 m_Tail
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Tail;    // 다음에 넣을 위치 (생산자가 갱신)
+    size_t m_CachedHead;                                    // 생산자가 마지막으로 읽은 m_Head
+
+public:
+    // 생성자: 용량을 2의 거듭제곱으로 올려서 버퍼를 할당합니다.
+    explicit SpscRingBuffer(size_t capacity)
+        : m_Head(0)
+        , m_CachedTail(0)
+        , m_Tail(0)
+        , m_CachedHead(0)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        m_Buffer.resize(size);
+        m_Mask = size - 1;
+    }
+
+    // 복사 생성자와 대입 연산자를 삭제하여 복사를 금지
+    SpscRingBuffer(const SpscRingBuffer<T>&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer<T>&) = delete;
+
+    // 생산자: 가득 차 있으면 false 를 반환하고 item 은 그대로 둡니다.
+    bool TryPush(T&& item)
+    {
+        size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail - m_CachedHead == m_Buffer.size())
+        {
+            // 캐시된 위치로는 가득 찬 것으로 보이면 실제 소비 위치를 다시 확인
+            m_CachedHead = m_Head.load(std::memory_order_acquire);
+            if (tail - m_CachedHead == m_Buffer.size())
+            {
+                return false;
+            }
+        }
+
+        m_Buffer[tail & m_Mask] = std::move(item);
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 소비자: 비어 있으면 false 를 반환합니다.
+    bool TryPop(T& item)
+    {
+        size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_CachedTail)
+        {
+            m_CachedTail = m_Tail.load(std::memory_order_acquire);
+            if (head == m_CachedTail)
+            {
+                return false;
+            }
+        }
+
+        // 꺼낸 슬롯은 비워서 요소의 수명이 버퍼에 남지 않도록 함
+        item = std::move(m_Buffer[head & m_Mask]);
+        m_Buffer[head & m_Mask] = T();
+        m_Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 현재 쌓여 있는 요소 수 (다른 스레드에서 호출하면 근사값)
+    size_t Size() const
+    {
+        // head 를 먼저 읽어야 tail - head 가 음수가 되지 않음
+        size_t head = m_Head.load(std::memory_order_acquire);
+        size_t tail = m_Tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    size_t Capacity() const
+    {
+        return m_Buffer.size();
+    }
+};
@@ -21,7 +21,8 @@ int main()
 	const auto& config = parser.getConfig();
 
 
-	HSThreadPool threadPool(10);
+	const size_t workerCount = 10;
+	HSThreadPool threadPool(workerCount);
 
 	// Redis 초기화
 	std::unique_ptr<CRedisClient> redisClient = std::make_unique<CRedisClient>();
@@ -42,15 +43,28 @@ int main()
 	}
 
 
-	// MySQL 초기화
-	std::unique_ptr<MySQLManager> mysqlManager = std::make_unique<MySQLManager>(config.at("mysql_host"), config.at("mysql_id"), config.at("mysql_pw"), config.at("mysql_db"));
+	// MySQL 초기화 (설정이 없으면 스레드 풀 워커 수만큼 연결을 만들어 DB 작업이 동시에 실행되도록 함)
+	size_t mysqlPoolSize = workerCount;
+	if (config.count("mysql_pool_size"))
+	{
+		mysqlPoolSize = std::stoul(config.at("mysql_pool_size"));
+	}
+	std::unique_ptr<MySQLManager> mysqlManager = std::make_unique<MySQLManager>(config.at("mysql_host"), config.at("mysql_id"), config.at("mysql_pw"), config.at("mysql_db"), 3306, mysqlPoolSize);
+	LOG_INFO("Connected to MySQL successfully. Pool size : %zu", mysqlManager->GetPoolSize());
 
 	// Socket Server 초기화
 	boost::asio::io_context io_context;
 	TcpServer tcpServer(io_context, 4242, std::move(redisClient), std::move(mysqlManager), threadPool);
 
+	// 세션 I/O 스레드 수 (설정이 없거나 0 이면 코어 수만큼 생성)
+	size_t ioThreadCount = 0;
+	if (config.count("io_thread_count"))
+	{
+		ioThreadCount = std::stoul(config.at("io_thread_count"));
+	}
+
 	int maxUser = 2;
-	if (!tcpServer.Start(maxUser))
+	if (!tcpServer.Start(maxUser, ioThreadCount))
 	{
 		LOG_ERROR("Tcp Server Start Error!!");
 	}